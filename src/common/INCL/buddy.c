@@ -0,0 +1,142 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "buddy.h"
+
+struct _incl_buddy_allocator {
+	size_t min_block_size;
+	unsigned int max_order;
+
+	/* Complete binary tree of blocks; every node holds the largest free order below it plus one, or zero if none is free. */
+	unsigned char *tree;
+
+	pthread_mutex_t mutex;
+};
+
+static void merge_buddy_blocks(incl_buddy_allocator buddy_allocator, size_t index, unsigned int order) {
+	while (index) {
+		index = (index - 1) / 2;
+		order++;
+
+		unsigned char left = buddy_allocator->tree[2 * index + 1];
+		unsigned char right = buddy_allocator->tree[2 * index + 2];
+
+		if (left == order && right == order) {
+			buddy_allocator->tree[index] = order + 1;
+		} else {
+			buddy_allocator->tree[index] = left > right ? left : right;
+		}
+	}
+}
+
+/* Allocates a block of at least size bytes, and returns its offset. */
+__attribute__ ((visibility ("hidden")))
+int inclAllocateBuddyBlock(incl_buddy_allocator buddy_allocator, size_t size, size_t *offset) {
+	unsigned int order = 0;
+	while ((buddy_allocator->min_block_size << order) < size) {
+		if (++order > buddy_allocator->max_order) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	pthread_mutex_lock(&buddy_allocator->mutex);
+
+	if (buddy_allocator->tree[0] < order + 1) {
+		pthread_mutex_unlock(&buddy_allocator->mutex);
+
+		return EXIT_FAILURE;
+	}
+
+	size_t index = 0;
+
+	unsigned int node_order;
+	for (node_order = buddy_allocator->max_order; node_order != order; node_order--) {
+		if (buddy_allocator->tree[2 * index + 1] >= order + 1) {
+			index = 2 * index + 1;
+		} else {
+			index = 2 * index + 2;
+		}
+	}
+
+	buddy_allocator->tree[index] = 0;
+
+	*offset = ((index + 1) - ((size_t) 1 << (buddy_allocator->max_order - order))) * (buddy_allocator->min_block_size << order);
+
+	merge_buddy_blocks(buddy_allocator, index, order);
+
+	pthread_mutex_unlock(&buddy_allocator->mutex);
+
+	return EXIT_SUCCESS;
+}
+
+/* Creates a buddy allocator over size bytes, which has to be min_block_size times a power of two. */
+__attribute__ ((visibility ("hidden")))
+incl_buddy_allocator inclCreateBuddyAllocator(size_t size, size_t min_block_size) {
+	incl_buddy_allocator buddy_allocator = (incl_buddy_allocator) calloc(1, sizeof(struct _incl_buddy_allocator));
+	if (!buddy_allocator) {
+		perror("Error: calloc");
+
+		return NULL;
+	}
+
+	buddy_allocator->min_block_size = min_block_size;
+	while ((min_block_size << buddy_allocator->max_order) < size) {
+		buddy_allocator->max_order++;
+	}
+
+	size_t num_nodes = ((size_t) 2 << buddy_allocator->max_order) - 1;
+
+	if (!(buddy_allocator->tree = (unsigned char *) calloc(num_nodes, sizeof(unsigned char)))) {
+		perror("Error: calloc");
+
+		free(buddy_allocator);
+
+		return NULL;
+	}
+
+	/* Every block starts out free. */
+	size_t index = 0;
+
+	unsigned int depth;
+	for (depth = 0; depth <= buddy_allocator->max_order; depth++) {
+		size_t i;
+		for (i = 0; i < ((size_t) 1 << depth); i++) {
+			buddy_allocator->tree[index++] = buddy_allocator->max_order - depth + 1;
+		}
+	}
+
+	pthread_mutex_init(&buddy_allocator->mutex, NULL);
+
+	return buddy_allocator;
+}
+
+/* Frees the block at offset, and merges it with its buddies where possible. */
+__attribute__ ((visibility ("hidden")))
+void inclFreeBuddyBlock(incl_buddy_allocator buddy_allocator, size_t offset) {
+	pthread_mutex_lock(&buddy_allocator->mutex);
+
+	/* Walk up from the smallest block at offset to the one that was handed out. */
+	size_t index = offset / buddy_allocator->min_block_size + ((size_t) 1 << buddy_allocator->max_order) - 1;
+
+	unsigned int order = 0;
+	while (buddy_allocator->tree[index]) {
+		index = (index - 1) / 2;
+		order++;
+	}
+
+	buddy_allocator->tree[index] = order + 1;
+
+	merge_buddy_blocks(buddy_allocator, index, order);
+
+	pthread_mutex_unlock(&buddy_allocator->mutex);
+}
+
+/* Releases the buddy allocator. */
+__attribute__ ((visibility ("hidden")))
+void inclReleaseBuddyAllocator(incl_buddy_allocator buddy_allocator) {
+	pthread_mutex_destroy(&buddy_allocator->mutex);
+
+	free(buddy_allocator->tree);
+	free(buddy_allocator);
+}
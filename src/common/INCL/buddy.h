@@ -0,0 +1,20 @@
+#ifndef BUDDY_H
+#define BUDDY_H
+
+#include <stddef.h>
+
+typedef struct _incl_buddy_allocator *incl_buddy_allocator;
+
+/* Allocates a block of at least size bytes, and returns its offset. */
+int inclAllocateBuddyBlock(incl_buddy_allocator buddy_allocator, size_t size, size_t *offset);
+
+/* Creates a buddy allocator over size bytes, which has to be min_block_size times a power of two. */
+incl_buddy_allocator inclCreateBuddyAllocator(size_t size, size_t min_block_size);
+
+/* Frees the block at offset, and merges it with its buddies where possible. */
+void inclFreeBuddyBlock(incl_buddy_allocator buddy_allocator, size_t offset);
+
+/* Releases the buddy allocator. */
+void inclReleaseBuddyAllocator(incl_buddy_allocator buddy_allocator);
+
+#endif
@@ -0,0 +1,182 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cache.h"
+
+#define NUM_SIZE_CLASSES (8 * sizeof(size_t))
+
+struct cached_mem {
+	/* Memory objects of the same size class. */
+	struct cached_mem *prev;
+	struct cached_mem *next;
+
+	/* All the memory objects, from the most to the least recently cached. */
+	struct cached_mem *older;
+	struct cached_mem *newer;
+
+	cl_mem mem;
+	size_t size;
+	void *host;
+};
+
+struct _incl_mem_cache {
+	size_t budget;
+	size_t size;
+
+	struct cached_mem *size_class[NUM_SIZE_CLASSES];
+	struct cached_mem *newest;
+	struct cached_mem *oldest;
+
+	pthread_mutex_t mutex;
+};
+
+static unsigned int get_size_class(size_t size) {
+	unsigned int size_class = 0;
+	while (size >>= 1) {
+		size_class++;
+	}
+
+	return size_class;
+}
+
+static void remove_cached_mem(incl_mem_cache mem_cache, struct cached_mem *cached_mem) {
+	if (cached_mem->prev) {
+		cached_mem->prev->next = cached_mem->next;
+	} else {
+		mem_cache->size_class[get_size_class(cached_mem->size)] = cached_mem->next;
+	}
+	if (cached_mem->next) {
+		cached_mem->next->prev = cached_mem->prev;
+	}
+
+	if (cached_mem->newer) {
+		cached_mem->newer->older = cached_mem->older;
+	} else {
+		mem_cache->newest = cached_mem->older;
+	}
+	if (cached_mem->older) {
+		cached_mem->older->newer = cached_mem->newer;
+	} else {
+		mem_cache->oldest = cached_mem->newer;
+	}
+
+	mem_cache->size -= cached_mem->size;
+}
+
+/* Keeps a memory object of size bytes, bound to host (or NULL), for reuse. Evicts the least recently cached ones to stay within budget, and fails if it still does not fit. */
+__attribute__ ((visibility ("hidden")))
+int inclCacheMemObject(incl_mem_cache mem_cache, cl_mem mem, size_t size, void *host) {
+	if (size > mem_cache->budget) {
+		return EXIT_FAILURE;
+	}
+
+	struct cached_mem *cached_mem = (struct cached_mem *) calloc(1, sizeof(struct cached_mem));
+	if (!cached_mem) {
+		perror("Error: calloc");
+
+		return EXIT_FAILURE;
+	}
+
+	cached_mem->mem = mem;
+	cached_mem->size = size;
+	cached_mem->host = host;
+
+	pthread_mutex_lock(&mem_cache->mutex);
+
+	while (mem_cache->size + size > mem_cache->budget) {
+		struct cached_mem *oldest = mem_cache->oldest;
+
+		remove_cached_mem(mem_cache, oldest);
+
+		inclReleaseMemObject(oldest->mem);
+
+		free(oldest);
+	}
+
+	unsigned int size_class = get_size_class(size);
+
+	cached_mem->next = mem_cache->size_class[size_class];
+	if (cached_mem->next) {
+		cached_mem->next->prev = cached_mem;
+	}
+	mem_cache->size_class[size_class] = cached_mem;
+
+	cached_mem->older = mem_cache->newest;
+	if (cached_mem->older) {
+		cached_mem->older->newer = cached_mem;
+	} else {
+		mem_cache->oldest = cached_mem;
+	}
+	mem_cache->newest = cached_mem;
+
+	mem_cache->size += size;
+
+	pthread_mutex_unlock(&mem_cache->mutex);
+
+	return EXIT_SUCCESS;
+}
+
+/* Creates a cache of up to budget bytes of memory objects. */
+__attribute__ ((visibility ("hidden")))
+incl_mem_cache inclCreateMemCache(size_t budget) {
+	incl_mem_cache mem_cache = (incl_mem_cache) calloc(1, sizeof(struct _incl_mem_cache));
+	if (!mem_cache) {
+		perror("Error: calloc");
+
+		return NULL;
+	}
+
+	mem_cache->budget = budget;
+
+	pthread_mutex_init(&mem_cache->mutex, NULL);
+
+	return mem_cache;
+}
+
+/* Releases the cache and all the memory objects it keeps. */
+__attribute__ ((visibility ("hidden")))
+void inclReleaseMemCache(incl_mem_cache mem_cache) {
+	while (mem_cache->oldest) {
+		struct cached_mem *oldest = mem_cache->oldest;
+
+		remove_cached_mem(mem_cache, oldest);
+
+		inclReleaseMemObject(oldest->mem);
+
+		free(oldest);
+	}
+
+	pthread_mutex_destroy(&mem_cache->mutex);
+
+	free(mem_cache);
+}
+
+/* Takes a cached memory object of exactly size bytes, bound to host (or NULL), if there is one. */
+__attribute__ ((visibility ("hidden")))
+cl_mem inclReuseMemObject(incl_mem_cache mem_cache, size_t size, void *host) {
+	pthread_mutex_lock(&mem_cache->mutex);
+
+	struct cached_mem *cached_mem;
+	for (cached_mem = mem_cache->size_class[get_size_class(size)]; cached_mem; cached_mem = cached_mem->next) {
+		if (cached_mem->size == size && cached_mem->host == host) {
+			break;
+		}
+	}
+
+	if (!cached_mem) {
+		pthread_mutex_unlock(&mem_cache->mutex);
+
+		return NULL;
+	}
+
+	remove_cached_mem(mem_cache, cached_mem);
+
+	pthread_mutex_unlock(&mem_cache->mutex);
+
+	cl_mem mem = cached_mem->mem;
+
+	free(cached_mem);
+
+	return mem;
+}
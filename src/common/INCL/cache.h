@@ -0,0 +1,20 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "opencl.h"
+
+typedef struct _incl_mem_cache *incl_mem_cache;
+
+/* Keeps a memory object of size bytes, bound to host (or NULL), for reuse. Evicts the least recently cached ones to stay within budget, and fails if it still does not fit. */
+int inclCacheMemObject(incl_mem_cache mem_cache, cl_mem mem, size_t size, void *host);
+
+/* Creates a cache of up to budget bytes of memory objects. */
+incl_mem_cache inclCreateMemCache(size_t budget);
+
+/* Releases the cache and all the memory objects it keeps. */
+void inclReleaseMemCache(incl_mem_cache mem_cache);
+
+/* Takes a cached memory object of exactly size bytes, bound to host (or NULL), if there is one. */
+cl_mem inclReuseMemObject(incl_mem_cache mem_cache, size_t size, void *host);
+
+#endif
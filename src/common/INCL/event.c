@@ -0,0 +1,418 @@
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "event.h"
+
+#if defined(__i386__) || defined(__x86_64__)
+#define CPU_RELAX() __asm__ __volatile__ ("pause" ::: "memory")
+#elif defined(__aarch64__)
+#define CPU_RELAX() __asm__ __volatile__ ("yield" ::: "memory")
+#else
+#define CPU_RELAX() __asm__ __volatile__ ("" ::: "memory")
+#endif
+
+#define SEC_TO_USEC(sec) ((sec) * 1000000)
+#define NSEC_TO_USEC(nsec) ((nsec) / 1000)
+#define USEC_TO_NSEC(usec) ((usec) * 1000)
+
+struct completion {
+	struct completion *next;
+
+	incl_completion_queue completion_queue;
+	cl_int status;
+
+	void (*callback)(int error, void *user_data);
+	void *user_data;
+};
+
+struct _incl_completion_queue {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+
+	struct completion *head;
+	struct completion *tail;
+	unsigned int pending;
+
+	pthread_t thread;
+	unsigned char release;
+	/* Released with callbacks still pending, so the last of them frees the completion queue. */
+	unsigned char abandoned;
+};
+
+struct _incl_eventfd {
+	int fd;
+	unsigned int refs;
+};
+
+struct waiter {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+
+	cl_int status;
+	unsigned char done;
+	unsigned int refs;
+};
+
+static void *completion_routine(void *arg) {
+	incl_completion_queue completion_queue = (incl_completion_queue) arg;
+
+	pthread_mutex_lock(&completion_queue->mutex);
+	for (;;) {
+		while (!completion_queue->head) {
+			if (completion_queue->release) {
+				pthread_mutex_unlock(&completion_queue->mutex);
+
+				return NULL;
+			}
+
+			pthread_cond_wait(&completion_queue->cond, &completion_queue->mutex);
+		}
+
+		struct completion *completion = completion_queue->head;
+		if (!(completion_queue->head = completion->next)) {
+			completion_queue->tail = NULL;
+		}
+
+		pthread_mutex_unlock(&completion_queue->mutex);
+
+		completion->callback(completion->status < 0 ? EXIT_FAILURE : EXIT_SUCCESS, completion->user_data);
+
+		free(completion);
+
+		pthread_mutex_lock(&completion_queue->mutex);
+		completion_queue->pending--;
+	}
+}
+
+static void CL_CALLBACK notify_eventfd(cl_event event, cl_int event_command_exec_status, void *user_data) {
+	incl_eventfd eventfd = (incl_eventfd) user_data;
+
+	uint64_t value = 1;
+	if (write(eventfd->fd, &value, sizeof(uint64_t)) != sizeof(uint64_t)) {
+		perror("Error: write");
+	}
+
+	inclReleaseEventfd(eventfd);
+}
+
+static void release_waiter(struct waiter *waiter) {
+	if (!__sync_sub_and_fetch(&waiter->refs, 1)) {
+		pthread_cond_destroy(&waiter->cond);
+		pthread_mutex_destroy(&waiter->mutex);
+
+		free(waiter);
+	}
+}
+
+static int spin_on_event(cl_event event, unsigned long spin_usec, cl_int *status) {
+	struct timespec tp;
+
+	clock_gettime(CLOCK_MONOTONIC, &tp);
+	unsigned long start = SEC_TO_USEC((unsigned long) tp.tv_sec) + NSEC_TO_USEC((unsigned long) tp.tv_nsec);
+
+	for (;;) {
+		if (inclGetEventInfo(event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(cl_int), status, NULL)) {
+			return EXIT_FAILURE;
+		}
+
+		if (*status <= CL_COMPLETE || !spin_usec) {
+			return EXIT_SUCCESS;
+		}
+
+		if (spin_usec != ULONG_MAX) {
+			clock_gettime(CLOCK_MONOTONIC, &tp);
+			unsigned long stop = SEC_TO_USEC((unsigned long) tp.tv_sec) + NSEC_TO_USEC((unsigned long) tp.tv_nsec);
+
+			if (stop - start >= spin_usec) {
+				return EXIT_SUCCESS;
+			}
+		}
+
+		CPU_RELAX();
+	}
+}
+
+static void CL_CALLBACK notify_waiter(cl_event event, cl_int event_command_exec_status, void *user_data) {
+	struct waiter *waiter = (struct waiter *) user_data;
+
+	pthread_mutex_lock(&waiter->mutex);
+	waiter->status = event_command_exec_status;
+	waiter->done = 1;
+	pthread_cond_signal(&waiter->cond);
+	pthread_mutex_unlock(&waiter->mutex);
+
+	release_waiter(waiter);
+}
+
+static void push_completion(struct completion *completion, cl_int status) {
+	incl_completion_queue completion_queue = completion->completion_queue;
+
+	completion->status = status;
+
+	pthread_mutex_lock(&completion_queue->mutex);
+	/* Events that complete after the release are abandoned, without running their callbacks. */
+	if (completion_queue->release) {
+		unsigned char last = !--completion_queue->pending && completion_queue->abandoned;
+		pthread_mutex_unlock(&completion_queue->mutex);
+
+		free(completion);
+
+		if (last) {
+			pthread_cond_destroy(&completion_queue->cond);
+			pthread_mutex_destroy(&completion_queue->mutex);
+
+			free(completion_queue);
+		}
+
+		return;
+	}
+
+	if (completion_queue->tail) {
+		completion_queue->tail->next = completion;
+	} else {
+		completion_queue->head = completion;
+	}
+	completion_queue->tail = completion;
+	pthread_cond_signal(&completion_queue->cond);
+	pthread_mutex_unlock(&completion_queue->mutex);
+}
+
+static void CL_CALLBACK notify_completion(cl_event event, cl_int event_command_exec_status, void *user_data) {
+	push_completion((struct completion *) user_data, event_command_exec_status);
+}
+
+/* Creates a completion queue, along with the thread that runs its callbacks. */
+__attribute__ ((visibility ("hidden")))
+incl_completion_queue inclCreateCompletionQueue(void) {
+	incl_completion_queue completion_queue = (incl_completion_queue) calloc(1, sizeof(struct _incl_completion_queue));
+	if (!completion_queue) {
+		perror("Error: calloc");
+
+		return NULL;
+	}
+
+	pthread_mutex_init(&completion_queue->mutex, NULL);
+	pthread_cond_init(&completion_queue->cond, NULL);
+
+	if (pthread_create(&completion_queue->thread, NULL, &completion_routine, completion_queue)) {
+		perror("Error: pthread_create");
+
+		pthread_cond_destroy(&completion_queue->cond);
+		pthread_mutex_destroy(&completion_queue->mutex);
+
+		free(completion_queue);
+
+		return NULL;
+	}
+
+	return completion_queue;
+}
+
+/* Creates a non-blocking eventfd, incremented once for every completed event it is signaled on. */
+__attribute__ ((visibility ("hidden")))
+incl_eventfd inclCreateEventfd(void) {
+	incl_eventfd object = (incl_eventfd) calloc(1, sizeof(struct _incl_eventfd));
+	if (!object) {
+		perror("Error: calloc");
+
+		return NULL;
+	}
+
+	if ((object->fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) == -1) {
+		perror("Error: eventfd");
+
+		free(object);
+
+		return NULL;
+	}
+
+	object->refs = 1;
+
+	return object;
+}
+
+/* Registers a callback to run on the completion queue thread once the event completes. */
+__attribute__ ((visibility ("hidden")))
+int inclEnqueueCompletion(incl_completion_queue completion_queue, cl_event event, void (*callback)(int error, void *user_data), void *user_data) {
+	struct completion *completion = (struct completion *) calloc(1, sizeof(struct completion));
+	if (!completion) {
+		perror("Error: calloc");
+
+		return EXIT_FAILURE;
+	}
+
+	completion->completion_queue = completion_queue;
+	completion->callback = callback;
+	completion->user_data = user_data;
+
+	pthread_mutex_lock(&completion_queue->mutex);
+	completion_queue->pending++;
+	pthread_mutex_unlock(&completion_queue->mutex);
+
+	if (!event) {
+		push_completion(completion, CL_COMPLETE);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (inclSetEventCallback(event, CL_COMPLETE, &notify_completion, completion)) {
+		pthread_mutex_lock(&completion_queue->mutex);
+		completion_queue->pending--;
+		pthread_mutex_unlock(&completion_queue->mutex);
+
+		free(completion);
+
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/* Returns the file descriptor of the eventfd. */
+__attribute__ ((visibility ("hidden")))
+int inclGetEventfdDescriptor(incl_eventfd eventfd) {
+	return eventfd->fd;
+}
+
+/* Runs the callbacks of the events completed so far, then releases the completion queue and its thread. The callbacks of the events still pending never run. */
+__attribute__ ((visibility ("hidden")))
+void inclReleaseCompletionQueue(incl_completion_queue completion_queue) {
+	pthread_mutex_lock(&completion_queue->mutex);
+	completion_queue->release = 1;
+	pthread_cond_signal(&completion_queue->cond);
+	pthread_mutex_unlock(&completion_queue->mutex);
+
+	pthread_join(completion_queue->thread, NULL);
+
+	/* Events that never complete would otherwise hold up the release forever. */
+	pthread_mutex_lock(&completion_queue->mutex);
+	if ((completion_queue->abandoned = completion_queue->pending ? 1 : 0)) {
+		pthread_mutex_unlock(&completion_queue->mutex);
+
+		return;
+	}
+	pthread_mutex_unlock(&completion_queue->mutex);
+
+	pthread_cond_destroy(&completion_queue->cond);
+	pthread_mutex_destroy(&completion_queue->mutex);
+
+	free(completion_queue);
+}
+
+/* Releases the eventfd. Its file descriptor is closed once no event is left to signal it. */
+__attribute__ ((visibility ("hidden")))
+void inclReleaseEventfd(incl_eventfd eventfd) {
+	if (!__sync_sub_and_fetch(&eventfd->refs, 1)) {
+		close(eventfd->fd);
+
+		free(eventfd);
+	}
+}
+
+/* Signals the eventfd once the event completes. */
+__attribute__ ((visibility ("hidden")))
+int inclSignalEventfd(incl_eventfd eventfd, cl_event event) {
+	__sync_add_and_fetch(&eventfd->refs, 1);
+
+	if (inclSetEventCallback(event, CL_COMPLETE, &notify_eventfd, eventfd)) {
+		inclReleaseEventfd(eventfd);
+
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/* Same as inclWaitForEvent, but gives up with ETIMEDOUT once timeout_usec microseconds have passed. */
+__attribute__ ((visibility ("hidden")))
+int inclTimedWaitForEvent(cl_event event, unsigned long spin_usec, unsigned long timeout_usec) {
+	struct timespec deadline;
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += timeout_usec / SEC_TO_USEC(1);
+	deadline.tv_nsec += USEC_TO_NSEC(timeout_usec % SEC_TO_USEC(1));
+	if (deadline.tv_nsec >= USEC_TO_NSEC(SEC_TO_USEC(1))) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= USEC_TO_NSEC(SEC_TO_USEC(1));
+	}
+
+	cl_int status;
+	if (spin_on_event(event, spin_usec < timeout_usec ? spin_usec : timeout_usec, &status)) {
+		return EXIT_FAILURE;
+	}
+
+	if (status <= CL_COMPLETE) {
+		return status < CL_COMPLETE ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	if (spin_usec >= timeout_usec) {
+		return ETIMEDOUT;
+	}
+
+	struct waiter *waiter = (struct waiter *) calloc(1, sizeof(struct waiter));
+	if (!waiter) {
+		perror("Error: calloc");
+
+		return EXIT_FAILURE;
+	}
+
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+	pthread_mutex_init(&waiter->mutex, NULL);
+	pthread_cond_init(&waiter->cond, &attr);
+
+	pthread_condattr_destroy(&attr);
+
+	/* One reference for this wait, one for the callback. */
+	waiter->refs = 2;
+
+	if (inclSetEventCallback(event, CL_COMPLETE, &notify_waiter, waiter)) {
+		pthread_cond_destroy(&waiter->cond);
+		pthread_mutex_destroy(&waiter->mutex);
+
+		free(waiter);
+
+		return EXIT_FAILURE;
+	}
+
+	int error = 0;
+
+	pthread_mutex_lock(&waiter->mutex);
+	while (!waiter->done && error != ETIMEDOUT) {
+		error = pthread_cond_timedwait(&waiter->cond, &waiter->mutex, &deadline);
+	}
+	if (waiter->done) {
+		error = waiter->status < CL_COMPLETE ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+	pthread_mutex_unlock(&waiter->mutex);
+
+	release_waiter(waiter);
+
+	return error;
+}
+
+/* Waits for the event to complete, spinning on its status for up to spin_usec microseconds (forever if ULONG_MAX) before blocking. */
+__attribute__ ((visibility ("hidden")))
+int inclWaitForEvent(cl_event event, unsigned long spin_usec) {
+	if (spin_usec) {
+		cl_int status;
+		if (spin_on_event(event, spin_usec, &status)) {
+			return EXIT_FAILURE;
+		}
+
+		if (status <= CL_COMPLETE) {
+			return status < CL_COMPLETE ? EXIT_FAILURE : EXIT_SUCCESS;
+		}
+	}
+
+	return inclWaitForEvents(1, &event);
+}
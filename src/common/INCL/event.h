@@ -0,0 +1,37 @@
+#ifndef EVENT_H
+#define EVENT_H
+
+#include "opencl.h"
+
+typedef struct _incl_completion_queue *incl_completion_queue;
+
+typedef struct _incl_eventfd *incl_eventfd;
+
+/* Creates a completion queue, along with the thread that runs its callbacks. */
+incl_completion_queue inclCreateCompletionQueue(void);
+
+/* Creates a non-blocking eventfd, incremented once for every completed event it is signaled on. */
+incl_eventfd inclCreateEventfd(void);
+
+/* Registers a callback to run on the completion queue thread once the event completes. */
+int inclEnqueueCompletion(incl_completion_queue completion_queue, cl_event event, void (*callback)(int error, void *user_data), void *user_data);
+
+/* Returns the file descriptor of the eventfd. */
+int inclGetEventfdDescriptor(incl_eventfd eventfd);
+
+/* Runs the callbacks of the events completed so far, then releases the completion queue and its thread. The callbacks of the events still pending never run. */
+void inclReleaseCompletionQueue(incl_completion_queue completion_queue);
+
+/* Releases the eventfd. Its file descriptor is closed once no event is left to signal it. */
+void inclReleaseEventfd(incl_eventfd eventfd);
+
+/* Signals the eventfd once the event completes. */
+int inclSignalEventfd(incl_eventfd eventfd, cl_event event);
+
+/* Same as inclWaitForEvent, but gives up with ETIMEDOUT once timeout_usec microseconds have passed. */
+int inclTimedWaitForEvent(cl_event event, unsigned long spin_usec, unsigned long timeout_usec);
+
+/* Waits for the event to complete, spinning on its status for up to spin_usec microseconds (forever if ULONG_MAX) before blocking. */
+int inclWaitForEvent(cl_event event, unsigned long spin_usec);
+
+#endif
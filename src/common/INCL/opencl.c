@@ -157,9 +157,9 @@ cl_mem inclCreateBuffer(cl_context context, cl_mem_flags flags, size_t size, voi
 
 /* Create a command-queue on a specific device. */
 __attribute__ ((visibility ("hidden")))
-cl_command_queue inclCreateCommandQueue(cl_context context, cl_device_id device) {
+cl_command_queue inclCreateCommandQueue(cl_context context, cl_device_id device, cl_command_queue_properties properties) {
 	cl_int errcode_ret;
-	cl_command_queue command_queue = clCreateCommandQueue(context, device, 0, &errcode_ret);
+	cl_command_queue command_queue = clCreateCommandQueue(context, device, properties, &errcode_ret);
 	if (errcode_ret != CL_SUCCESS || !command_queue) {
 		fprintf(stderr, "Error: clCreateCommandQueue %s (%d)\n", clError(errcode_ret), errcode_ret);
 		return NULL;
@@ -207,10 +207,84 @@ cl_program inclCreateProgramWithBinary(cl_context context, cl_device_id device,
 	}
 }
 
+/* Creates a buffer object (referred to as a sub-buffer object) from an existing buffer object. */
+__attribute__ ((visibility ("hidden")))
+cl_mem inclCreateSubBuffer(cl_mem buffer, cl_mem_flags flags, cl_buffer_create_type buffer_create_type, const void *buffer_create_info) {
+	cl_int errcode_ret;
+	cl_mem mem = clCreateSubBuffer(buffer, flags, buffer_create_type, buffer_create_info, &errcode_ret);
+	if (errcode_ret != CL_SUCCESS || !mem) {
+		fprintf(stderr, "Error: clCreateSubBuffer %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return NULL;
+	} else {
+		return mem;
+	}
+}
+
+/* Enqueues a command to copy from one buffer object to another. */
+__attribute__ ((visibility ("hidden")))
+int inclEnqueueCopyBuffer(cl_command_queue command_queue, cl_mem src_buffer, cl_mem dst_buffer, size_t src_offset, size_t dst_offset, size_t cb, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueCopyBuffer(command_queue, src_buffer, dst_buffer, src_offset, dst_offset, cb, num_events_in_wait_list, event_wait_list, event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clEnqueueCopyBuffer %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
+/* Enqueues a command to fill a buffer object with a pattern of a given pattern size. */
+__attribute__ ((visibility ("hidden")))
+int inclEnqueueFillBuffer(cl_command_queue command_queue, cl_mem buffer, const void *pattern, size_t pattern_size, size_t offset, size_t size, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueFillBuffer(command_queue, buffer, pattern, pattern_size, offset, size, num_events_in_wait_list, event_wait_list, event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clEnqueueFillBuffer %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
+/* Enqueues a command to map a region of the buffer object given by buffer into the host address space and returns a pointer to this mapped region. */
+__attribute__ ((visibility ("hidden")))
+void *inclEnqueueMapBuffer(cl_command_queue command_queue, cl_mem buffer, cl_bool blocking_map, cl_map_flags map_flags, size_t offset, size_t size, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret;
+	void *ptr = clEnqueueMapBuffer(command_queue, buffer, blocking_map, map_flags, offset, size, num_events_in_wait_list, event_wait_list, event, &errcode_ret);
+	if (errcode_ret != CL_SUCCESS || !ptr) {
+		fprintf(stderr, "Error: clEnqueueMapBuffer %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return NULL;
+	} else {
+		return ptr;
+	}
+}
+
+/* Enqueues a marker command which waits for a list of events to complete. */
+__attribute__ ((visibility ("hidden")))
+int inclEnqueueMarkerWithWaitList(cl_command_queue command_queue, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueMarkerWithWaitList(command_queue, num_events_in_wait_list, event_wait_list, event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clEnqueueMarkerWithWaitList %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
 /* Enqueues a command to indicate which device a memory object should be associated with. */
 __attribute__ ((visibility ("hidden")))
-int inclEnqueueMigrateMemObject(cl_command_queue command_queue, cl_mem mem_object, cl_mem_migration_flags flags) {
-	cl_int errcode_ret = clEnqueueMigrateMemObjects(command_queue, 1, &mem_object, flags, 0, NULL, NULL);
+int inclEnqueueMigrateMemObject(cl_command_queue command_queue, cl_mem mem_object, cl_mem_migration_flags flags, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueMigrateMemObjects(command_queue, 1, &mem_object, flags, num_events_in_wait_list, event_wait_list, event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clEnqueueMigrateMemObjects %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
+/* Enqueues a command to indicate which device a set of memory objects should be associated with. */
+__attribute__ ((visibility ("hidden")))
+int inclEnqueueMigrateMemObjects(cl_command_queue command_queue, cl_uint num_mem_objects, const cl_mem *mem_objects, cl_mem_migration_flags flags, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueMigrateMemObjects(command_queue, num_mem_objects, mem_objects, flags, num_events_in_wait_list, event_wait_list, event);
 	if (errcode_ret != CL_SUCCESS) {
 		fprintf(stderr, "Error: clEnqueueMigrateMemObjects %s (%d)\n", clError(errcode_ret), errcode_ret);
 		return EXIT_FAILURE;
@@ -221,8 +295,8 @@ int inclEnqueueMigrateMemObject(cl_command_queue command_queue, cl_mem mem_objec
 
 /* Enqueue commands to read from a buffer object to host memory. */
 __attribute__ ((visibility ("hidden")))
-int inclEnqueueReadBuffer(cl_command_queue command_queue, cl_mem buffer, size_t offset, size_t cb, void *ptr) {
-	cl_int errcode_ret = clEnqueueReadBuffer(command_queue, buffer, CL_FALSE, offset, cb, ptr, 0, NULL, NULL);
+int inclEnqueueReadBuffer(cl_command_queue command_queue, cl_mem buffer, size_t offset, size_t cb, void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueReadBuffer(command_queue, buffer, CL_FALSE, offset, cb, ptr, num_events_in_wait_list, event_wait_list, event);
 	if (errcode_ret != CL_SUCCESS) {
 		fprintf(stderr, "Error: clEnqueueReadBuffer %s (%d)\n", clError(errcode_ret), errcode_ret);
 		return EXIT_FAILURE;
@@ -231,10 +305,22 @@ int inclEnqueueReadBuffer(cl_command_queue command_queue, cl_mem buffer, size_t
 	}
 }
 
+/* Enqueue command to read from a 2D or 3D rectangular region from a buffer object to host memory. */
+__attribute__ ((visibility ("hidden")))
+int inclEnqueueReadBufferRect(cl_command_queue command_queue, cl_mem buffer, const size_t *buffer_origin, const size_t *host_origin, const size_t *region, size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch, void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueReadBufferRect(command_queue, buffer, CL_FALSE, buffer_origin, host_origin, region, buffer_row_pitch, buffer_slice_pitch, host_row_pitch, host_slice_pitch, ptr, num_events_in_wait_list, event_wait_list, event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clEnqueueReadBufferRect %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
 /* Enqueues a command to execute a kernel on a device. */
 __attribute__ ((visibility ("hidden")))
-int inclEnqueueTask(cl_command_queue command_queue, cl_kernel kernel) {
-	cl_int errcode_ret = clEnqueueTask(command_queue, kernel, 0, NULL, NULL);
+int inclEnqueueTask(cl_command_queue command_queue, cl_kernel kernel, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueTask(command_queue, kernel, num_events_in_wait_list, event_wait_list, event);
 	if (errcode_ret != CL_SUCCESS) {
 		fprintf(stderr, "Error: clEnqueueTask %s (%d)\n", clError(errcode_ret), errcode_ret);
 		return EXIT_FAILURE;
@@ -243,10 +329,22 @@ int inclEnqueueTask(cl_command_queue command_queue, cl_kernel kernel) {
 	}
 }
 
+/* Enqueues a command to unmap a previously mapped region of a memory object. */
+__attribute__ ((visibility ("hidden")))
+int inclEnqueueUnmapMemObject(cl_command_queue command_queue, cl_mem memobj, void *mapped_ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueUnmapMemObject(command_queue, memobj, mapped_ptr, num_events_in_wait_list, event_wait_list, event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clEnqueueUnmapMemObject %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
 /* Enqueue commands to write to a buffer object from host memory. */
 __attribute__ ((visibility ("hidden")))
-int inclEnqueueWriteBuffer(cl_command_queue command_queue, cl_mem buffer, size_t offset, size_t cb, const void *ptr) {
-	cl_int errcode_ret = clEnqueueWriteBuffer(command_queue, buffer, CL_FALSE, offset, cb, ptr, 0, NULL, NULL);
+int inclEnqueueWriteBuffer(cl_command_queue command_queue, cl_mem buffer, size_t offset, size_t cb, const void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueWriteBuffer(command_queue, buffer, CL_FALSE, offset, cb, ptr, num_events_in_wait_list, event_wait_list, event);
 	if (errcode_ret != CL_SUCCESS) {
 		fprintf(stderr, "Error: clEnqueueWriteBuffer %s (%d)\n", clError(errcode_ret), errcode_ret);
 		return EXIT_FAILURE;
@@ -255,6 +353,18 @@ int inclEnqueueWriteBuffer(cl_command_queue command_queue, cl_mem buffer, size_t
 	}
 }
 
+/* Enqueue command to write a 2D or 3D rectangular region to a buffer object from host memory. */
+__attribute__ ((visibility ("hidden")))
+int inclEnqueueWriteBufferRect(cl_command_queue command_queue, cl_mem buffer, const size_t *buffer_origin, const size_t *host_origin, const size_t *region, size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch, const void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	cl_int errcode_ret = clEnqueueWriteBufferRect(command_queue, buffer, CL_FALSE, buffer_origin, host_origin, region, buffer_row_pitch, buffer_slice_pitch, host_row_pitch, host_slice_pitch, ptr, num_events_in_wait_list, event_wait_list, event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clEnqueueWriteBufferRect %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
 /* Blocks until all previously queued OpenCL commands in a command-queue are issued to the associated device and have completed. */
 __attribute__ ((visibility ("hidden")))
 int inclFinish(cl_command_queue command_queue) {
@@ -267,6 +377,30 @@ int inclFinish(cl_command_queue command_queue) {
 	}
 }
 
+/* Issues all previously queued OpenCL commands in a command-queue to the device associated with the command-queue. */
+__attribute__ ((visibility ("hidden")))
+int inclFlush(cl_command_queue command_queue) {
+	cl_int errcode_ret = clFlush(command_queue);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clFlush %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
+/* Returns information about the command-queue. */
+__attribute__ ((visibility ("hidden")))
+int inclGetCommandQueueInfo(cl_command_queue command_queue, cl_command_queue_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret) {
+	cl_int errcode_ret = clGetCommandQueueInfo(command_queue, param_name, param_value_size, param_value, param_value_size_ret);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clGetCommandQueueInfo %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
 /* Obtain specified device, if available. */
 __attribute__ ((visibility ("hidden")))
 cl_device_id inclGetDeviceID(cl_platform_id platform, cl_uint device_id) {
@@ -325,6 +459,18 @@ int inclGetDeviceInfo(cl_device_id device, cl_device_info param_name, size_t par
 	}
 }
 
+/* Returns information about the event object. */
+__attribute__ ((visibility ("hidden")))
+int inclGetEventInfo(cl_event event, cl_event_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret) {
+	cl_int errcode_ret = clGetEventInfo(event, param_name, param_value_size, param_value, param_value_size_ret);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clGetEventInfo %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
 /* Get specific information about the OpenCL kernel. */
 __attribute__ ((visibility ("hidden")))
 int inclGetKernelInfo(cl_kernel kernel, cl_kernel_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret) {
@@ -447,6 +593,18 @@ int inclReleaseContext(cl_context context) {
 	}
 }
 
+/* Decrements the event reference count. */
+__attribute__ ((visibility ("hidden")))
+int inclReleaseEvent(cl_event event) {
+	cl_int errcode_ret = clReleaseEvent(event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clReleaseEvent %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
 /* Decrements the kernel reference count. */
 __attribute__ ((visibility ("hidden")))
 int inclReleaseKernel(cl_kernel kernel) {
@@ -483,6 +641,42 @@ int inclReleaseProgram(cl_program program) {
 	}
 }
 
+/* Increments the command_queue reference count. */
+__attribute__ ((visibility ("hidden")))
+int inclRetainCommandQueue(cl_command_queue command_queue) {
+	cl_int errcode_ret = clRetainCommandQueue(command_queue);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clRetainCommandQueue %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
+/* Increments the event reference count. */
+__attribute__ ((visibility ("hidden")))
+int inclRetainEvent(cl_event event) {
+	cl_int errcode_ret = clRetainEvent(event);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clRetainEvent %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
+/* Registers a user callback function for a specific command execution status. */
+__attribute__ ((visibility ("hidden")))
+int inclSetEventCallback(cl_event event, cl_int command_exec_callback_type, void (CL_CALLBACK *pfn_notify)(cl_event event, cl_int event_command_exec_status, void *user_data), void *user_data) {
+	cl_int errcode_ret = clSetEventCallback(event, command_exec_callback_type, pfn_notify, user_data);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clSetEventCallback %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
+
 /* Used to set the argument value for a specific argument of a kernel. */
 __attribute__ ((visibility ("hidden")))
 int inclSetKernelArg(cl_kernel kernel, cl_uint arg_index, size_t arg_size, const void *arg_value) {
@@ -494,3 +688,15 @@ int inclSetKernelArg(cl_kernel kernel, cl_uint arg_index, size_t arg_size, const
 		return EXIT_SUCCESS;
 	}
 }
+
+/* Waits on the host thread for commands identified by event objects to complete. */
+__attribute__ ((visibility ("hidden")))
+int inclWaitForEvents(cl_uint num_events, const cl_event *event_list) {
+	cl_int errcode_ret = clWaitForEvents(num_events, event_list);
+	if (errcode_ret != CL_SUCCESS) {
+		fprintf(stderr, "Error: clWaitForEvents %s (%d)\n", clError(errcode_ret), errcode_ret);
+		return EXIT_FAILURE;
+	} else {
+		return EXIT_SUCCESS;
+	}
+}
@@ -11,7 +11,7 @@ int inclBuildProgram(cl_program program);
 cl_mem inclCreateBuffer(cl_context context, cl_mem_flags flags, size_t size, void *host_ptr);
 
 /* Create a command-queue on a specific device. */
-cl_command_queue inclCreateCommandQueue(cl_context context, cl_device_id device);
+cl_command_queue inclCreateCommandQueue(cl_context context, cl_device_id device, cl_command_queue_properties properties);
 
 /* Creates an OpenCL context. */
 cl_context inclCreateContext(const cl_device_id device);
@@ -22,21 +22,54 @@ cl_kernel inclCreateKernel(cl_program program, const char *kernel_name);
 /* Creates a program object for a context, and loads specified binary data into the program object. */
 cl_program inclCreateProgramWithBinary(cl_context context, cl_device_id device, size_t length, const unsigned char *binary);
 
+/* Creates a buffer object (referred to as a sub-buffer object) from an existing buffer object. */
+cl_mem inclCreateSubBuffer(cl_mem buffer, cl_mem_flags flags, cl_buffer_create_type buffer_create_type, const void *buffer_create_info);
+
+/* Enqueues a command to copy from one buffer object to another. */
+int inclEnqueueCopyBuffer(cl_command_queue command_queue, cl_mem src_buffer, cl_mem dst_buffer, size_t src_offset, size_t dst_offset, size_t cb, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+
+/* Enqueues a command to fill a buffer object with a pattern of a given pattern size. */
+int inclEnqueueFillBuffer(cl_command_queue command_queue, cl_mem buffer, const void *pattern, size_t pattern_size, size_t offset, size_t size, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+
+/* Enqueues a command to map a region of the buffer object given by buffer into the host address space and returns a pointer to this mapped region. */
+void *inclEnqueueMapBuffer(cl_command_queue command_queue, cl_mem buffer, cl_bool blocking_map, cl_map_flags map_flags, size_t offset, size_t size, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+
+/* Enqueues a marker command which waits for a list of events to complete. */
+int inclEnqueueMarkerWithWaitList(cl_command_queue command_queue, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+
 /* Enqueues a command to indicate which device a memory object should be associated with. */
-int inclEnqueueMigrateMemObject(cl_command_queue command_queue, cl_mem memobj, cl_mem_migration_flags flags);
+int inclEnqueueMigrateMemObject(cl_command_queue command_queue, cl_mem memobj, cl_mem_migration_flags flags, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+
+/* Enqueues a command to indicate which device a set of memory objects should be associated with. */
+int inclEnqueueMigrateMemObjects(cl_command_queue command_queue, cl_uint num_mem_objects, const cl_mem *mem_objects, cl_mem_migration_flags flags, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
 
 /* Enqueue commands to read from a buffer object to host memory. */
-int inclEnqueueReadBuffer(cl_command_queue command_queue, cl_mem buffer, size_t offset, size_t cb, void *ptr);
+int inclEnqueueReadBuffer(cl_command_queue command_queue, cl_mem buffer, size_t offset, size_t cb, void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+
+/* Enqueue command to read from a 2D or 3D rectangular region from a buffer object to host memory. */
+int inclEnqueueReadBufferRect(cl_command_queue command_queue, cl_mem buffer, const size_t *buffer_origin, const size_t *host_origin, const size_t *region, size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch, void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
 
 /* Enqueues a command to execute a kernel on a device. */
-int inclEnqueueTask(cl_command_queue command_queue, cl_kernel kernel);
+int inclEnqueueTask(cl_command_queue command_queue, cl_kernel kernel, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+
+/* Enqueues a command to unmap a previously mapped region of a memory object. */
+int inclEnqueueUnmapMemObject(cl_command_queue command_queue, cl_mem memobj, void *mapped_ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
 
 /* Enqueue commands to write to a buffer object from host memory. */
-int inclEnqueueWriteBuffer(cl_command_queue command_queue, cl_mem buffer, size_t offset, size_t cb, const void *ptr);
+int inclEnqueueWriteBuffer(cl_command_queue command_queue, cl_mem buffer, size_t offset, size_t cb, const void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+
+/* Enqueue command to write a 2D or 3D rectangular region to a buffer object from host memory. */
+int inclEnqueueWriteBufferRect(cl_command_queue command_queue, cl_mem buffer, const size_t *buffer_origin, const size_t *host_origin, const size_t *region, size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch, const void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
 
 /* Blocks until all previously queued OpenCL commands in a command-queue are issued to the associated device and have completed. */
 int inclFinish(cl_command_queue command_queue);
 
+/* Issues all previously queued OpenCL commands in a command-queue to the device associated with the command-queue. */
+int inclFlush(cl_command_queue command_queue);
+
+/* Returns information about the command-queue. */
+int inclGetCommandQueueInfo(cl_command_queue command_queue, cl_command_queue_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret);
+
 /* Obtain specified device, if available. */
 cl_device_id inclGetDeviceID(cl_platform_id platform, cl_uint device_id);
 
@@ -46,6 +79,9 @@ int inclGetDeviceIDs(cl_platform_id platform, cl_uint num_entries, cl_device_id
 /* Get specific information about the OpenCL device. */
 int inclGetDeviceInfo(cl_device_id device, cl_device_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret);
 
+/* Returns information about the event object. */
+int inclGetEventInfo(cl_event event, cl_event_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret);
+
 /* Get specific information about the OpenCL kernel. */
 int inclGetKernelInfo(cl_kernel kernel, cl_kernel_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret);
 
@@ -67,6 +103,9 @@ int inclReleaseCommandQueue(cl_command_queue command_queue);
 /* Decrement the context reference count. */
 int inclReleaseContext(cl_context context);
 
+/* Decrements the event reference count. */
+int inclReleaseEvent(cl_event event);
+
 /* Decrements the kernel reference count. */
 int inclReleaseKernel(cl_kernel kernel);
 
@@ -76,7 +115,19 @@ int inclReleaseMemObject(cl_mem memobj);
 /* Decrements the program reference count. */
 int inclReleaseProgram(cl_program program);
 
+/* Increments the command_queue reference count. */
+int inclRetainCommandQueue(cl_command_queue command_queue);
+
+/* Increments the event reference count. */
+int inclRetainEvent(cl_event event);
+
+/* Registers a user callback function for a specific command execution status. */
+int inclSetEventCallback(cl_event event, cl_int command_exec_callback_type, void (CL_CALLBACK *pfn_notify)(cl_event event, cl_int event_command_exec_status, void *user_data), void *user_data);
+
 /* Used to set the argument value for a specific argument of a kernel. */
 int inclSetKernelArg(cl_kernel kernel, cl_uint arg_index, size_t arg_size, const void *arg_value);
 
+/* Waits on the host thread for commands identified by event objects to complete. */
+int inclWaitForEvents(cl_uint num_events, const cl_event *event_list);
+
 #endif
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "pool.h"
+
+#define DEFAULT_POOL_SIZE 4
+
+struct _incl_command_queue_pool {
+	cl_uint num_command_queues;
+	cl_command_queue *command_queues;
+
+	unsigned char per_thread;
+	unsigned int next;
+};
+
+/* Creates a pool of command-queues on a specific device. */
+__attribute__ ((visibility ("hidden")))
+incl_command_queue_pool inclCreateCommandQueuePool(cl_context context, cl_device_id device) {
+	incl_command_queue_pool pool = (incl_command_queue_pool) calloc(1, sizeof(struct _incl_command_queue_pool));
+	if (!pool) {
+		perror("Error: calloc");
+
+		return NULL;
+	}
+
+	pool->num_command_queues = DEFAULT_POOL_SIZE;
+
+	const char *size = getenv("INACCEL_COMMAND_QUEUE_POOL_SIZE");
+	if (size && strtoul(size, NULL, 10)) {
+		pool->num_command_queues = strtoul(size, NULL, 10);
+	}
+
+	const char *policy = getenv("INACCEL_COMMAND_QUEUE_POOL_POLICY");
+	if (policy && !strcmp(policy, "thread")) {
+		pool->per_thread = 1;
+	}
+
+	if (!(pool->command_queues = (cl_command_queue *) calloc(pool->num_command_queues, sizeof(cl_command_queue)))) {
+		perror("Error: calloc");
+
+		free(pool);
+
+		return NULL;
+	}
+
+	cl_command_queue_properties properties;
+	if (inclGetDeviceInfo(device, CL_DEVICE_QUEUE_PROPERTIES, sizeof(cl_command_queue_properties), &properties, NULL)) {
+		properties = 0;
+	}
+
+	/* Commands are ordered through their event wait lists, so out-of-order execution is enabled wherever the device supports it. */
+	properties &= CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+
+	cl_uint i;
+	for (i = 0; i < pool->num_command_queues; i++) {
+		if (!(pool->command_queues[i] = inclCreateCommandQueue(context, device, properties))) {
+			pool->num_command_queues = i;
+
+			inclReleaseCommandQueuePool(pool);
+
+			return NULL;
+		}
+	}
+
+	return pool;
+}
+
+/* Issues all previously queued commands of the pool to the device. */
+__attribute__ ((visibility ("hidden")))
+int inclFlushCommandQueuePool(incl_command_queue_pool pool) {
+	int error = EXIT_SUCCESS;
+
+	cl_uint i;
+	for (i = 0; i < pool->num_command_queues; i++) {
+		if (inclFlush(pool->command_queues[i])) {
+			error = EXIT_FAILURE;
+		}
+	}
+
+	return error;
+}
+
+/* Returns the index-th command-queue of the pool, wrapping around. */
+__attribute__ ((visibility ("hidden")))
+cl_command_queue inclGetCommandQueue(incl_command_queue_pool pool, unsigned int index) {
+	return pool->command_queues[index % pool->num_command_queues];
+}
+
+/* Leases a retained command-queue from the pool, for the caller to release once done with it. */
+__attribute__ ((visibility ("hidden")))
+cl_command_queue inclLeaseCommandQueue(incl_command_queue_pool pool) {
+	cl_command_queue command_queue;
+	if (pool->per_thread) {
+		command_queue = pool->command_queues[(unsigned long) syscall(SYS_gettid) % pool->num_command_queues];
+	} else {
+		command_queue = pool->command_queues[__sync_fetch_and_add(&pool->next, 1) % pool->num_command_queues];
+	}
+
+	inclRetainCommandQueue(command_queue);
+
+	return command_queue;
+}
+
+/* Releases the pool and all of its command-queues. */
+__attribute__ ((visibility ("hidden")))
+void inclReleaseCommandQueuePool(incl_command_queue_pool pool) {
+	cl_uint i;
+	for (i = 0; i < pool->num_command_queues; i++) {
+		inclReleaseCommandQueue(pool->command_queues[i]);
+	}
+
+	free(pool->command_queues);
+	free(pool);
+}
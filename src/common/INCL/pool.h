@@ -0,0 +1,23 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "opencl.h"
+
+typedef struct _incl_command_queue_pool *incl_command_queue_pool;
+
+/* Creates a pool of command-queues on a specific device. */
+incl_command_queue_pool inclCreateCommandQueuePool(cl_context context, cl_device_id device);
+
+/* Issues all previously queued commands of the pool to the device. */
+int inclFlushCommandQueuePool(incl_command_queue_pool pool);
+
+/* Returns the index-th command-queue of the pool, wrapping around. */
+cl_command_queue inclGetCommandQueue(incl_command_queue_pool pool, unsigned int index);
+
+/* Leases a retained command-queue from the pool, for the caller to release once done with it. */
+cl_command_queue inclLeaseCommandQueue(incl_command_queue_pool pool);
+
+/* Releases the pool and all of its command-queues. */
+void inclReleaseCommandQueuePool(incl_command_queue_pool pool);
+
+#endif
@@ -0,0 +1,319 @@
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "submit.h"
+
+#define MAX_SUBMISSION_BATCH 64
+
+#define SEC_TO_USEC(sec) ((sec) * 1000000)
+#define NSEC_TO_USEC(nsec) ((nsec) / 1000)
+#define USEC_TO_NSEC(usec) ((usec) * 1000)
+
+struct submission {
+	struct submission *volatile next;
+
+	void (*routine)(void *arg);
+	char arg[0] __attribute__ ((aligned));
+};
+
+struct _incl_submission_queue {
+	/* Producers swap themselves in at the head, the submission thread pops from the tail. */
+	struct submission *volatile head;
+	struct submission *tail;
+	struct submission stub;
+	/* Held by producers across numbering and pushing, so that submissions are queued in the order of their sequence numbers. */
+	int lock;
+
+	unsigned long submitted;
+	unsigned long completed;
+
+	void (*flush)(void *user_data);
+	void *user_data;
+
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	pthread_cond_t idle;
+	unsigned int sleeping;
+	unsigned int waiters;
+
+	pthread_t thread;
+	unsigned char release;
+};
+
+static void push_submission(incl_submission_queue submission_queue, struct submission *submission) {
+	submission->next = NULL;
+
+	struct submission *prev;
+	do {
+		prev = submission_queue->head;
+	} while (!__sync_bool_compare_and_swap(&submission_queue->head, prev, submission));
+
+	prev->next = submission;
+}
+
+static struct submission *pop_submission(incl_submission_queue submission_queue) {
+	struct submission *tail = submission_queue->tail;
+	struct submission *next = tail->next;
+
+	if (tail == &submission_queue->stub) {
+		if (!next) {
+			return NULL;
+		}
+
+		submission_queue->tail = next;
+		tail = next;
+		next = next->next;
+	}
+
+	if (next) {
+		submission_queue->tail = next;
+
+		return tail;
+	}
+
+	/* A producer is halfway through its push. */
+	if (tail != submission_queue->head) {
+		return NULL;
+	}
+
+	push_submission(submission_queue, &submission_queue->stub);
+
+	if ((next = tail->next)) {
+		submission_queue->tail = next;
+
+		return tail;
+	}
+
+	return NULL;
+}
+
+static void *submission_routine(void *arg) {
+	incl_submission_queue submission_queue = (incl_submission_queue) arg;
+
+	unsigned long batch = 0;
+
+	for (;;) {
+		struct submission *submission = pop_submission(submission_queue);
+		if (submission) {
+			submission->routine(submission->arg);
+
+			free(submission);
+
+			batch++;
+
+			/* Keep batching, unless someone is waiting on the submissions or a busy producer would hold back the flush of those already run. */
+			if (!submission_queue->waiters && batch < MAX_SUBMISSION_BATCH) {
+				continue;
+			}
+		} else if (submission_queue->head != submission_queue->tail) {
+			sched_yield();
+
+			continue;
+		}
+
+		if (batch) {
+			/* Submissions only count as run once flushed. */
+			if (submission_queue->flush) {
+				submission_queue->flush(submission_queue->user_data);
+			}
+
+			__sync_add_and_fetch(&submission_queue->completed, batch);
+			batch = 0;
+
+			if (submission_queue->waiters) {
+				pthread_mutex_lock(&submission_queue->mutex);
+				pthread_cond_broadcast(&submission_queue->idle);
+				pthread_mutex_unlock(&submission_queue->mutex);
+			}
+
+			continue;
+		}
+
+		pthread_mutex_lock(&submission_queue->mutex);
+		if (submission_queue->release) {
+			pthread_mutex_unlock(&submission_queue->mutex);
+
+			return NULL;
+		}
+
+		submission_queue->sleeping = 1;
+		__sync_synchronize();
+
+		if (submission_queue->head == submission_queue->tail) {
+			while (submission_queue->sleeping) {
+				pthread_cond_wait(&submission_queue->cond, &submission_queue->mutex);
+			}
+		} else {
+			submission_queue->sleeping = 0;
+		}
+		pthread_mutex_unlock(&submission_queue->mutex);
+	}
+}
+
+/* Allocates a submission that calls routine with a copy of its size bytes argument, and returns that argument for the caller to fill in. */
+__attribute__ ((visibility ("hidden")))
+void *inclCreateSubmission(void (*routine)(void *arg), size_t size) {
+	struct submission *submission = (struct submission *) calloc(1, sizeof(struct submission) + size);
+	if (!submission) {
+		perror("Error: calloc");
+
+		return NULL;
+	}
+
+	submission->routine = routine;
+
+	return submission->arg;
+}
+
+/* Creates a submission queue, along with the thread that runs its submissions in order and calls flush after every batch. */
+__attribute__ ((visibility ("hidden")))
+incl_submission_queue inclCreateSubmissionQueue(void (*flush)(void *user_data), void *user_data) {
+	incl_submission_queue submission_queue = (incl_submission_queue) calloc(1, sizeof(struct _incl_submission_queue));
+	if (!submission_queue) {
+		perror("Error: calloc");
+
+		return NULL;
+	}
+
+	submission_queue->head = &submission_queue->stub;
+	submission_queue->tail = &submission_queue->stub;
+
+	submission_queue->flush = flush;
+	submission_queue->user_data = user_data;
+
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+	pthread_mutex_init(&submission_queue->mutex, NULL);
+	pthread_cond_init(&submission_queue->cond, NULL);
+	pthread_cond_init(&submission_queue->idle, &attr);
+
+	pthread_condattr_destroy(&attr);
+
+	if (pthread_create(&submission_queue->thread, NULL, &submission_routine, submission_queue)) {
+		perror("Error: pthread_create");
+
+		pthread_cond_destroy(&submission_queue->idle);
+		pthread_cond_destroy(&submission_queue->cond);
+		pthread_mutex_destroy(&submission_queue->mutex);
+
+		free(submission_queue);
+
+		return NULL;
+	}
+
+	return submission_queue;
+}
+
+/* Runs all pending submissions, then releases the submission queue and its thread. */
+__attribute__ ((visibility ("hidden")))
+void inclReleaseSubmissionQueue(incl_submission_queue submission_queue) {
+	pthread_mutex_lock(&submission_queue->mutex);
+	submission_queue->release = 1;
+	submission_queue->sleeping = 0;
+	pthread_cond_signal(&submission_queue->cond);
+	pthread_mutex_unlock(&submission_queue->mutex);
+
+	pthread_join(submission_queue->thread, NULL);
+
+	pthread_cond_destroy(&submission_queue->idle);
+	pthread_cond_destroy(&submission_queue->cond);
+	pthread_mutex_destroy(&submission_queue->mutex);
+
+	free(submission_queue);
+}
+
+/* Pushes a submission to the queue, and returns its sequence number. */
+__attribute__ ((visibility ("hidden")))
+unsigned long inclSubmit(incl_submission_queue submission_queue, void *arg) {
+	struct submission *submission = (struct submission *) ((char *) arg - offsetof(struct submission, arg));
+
+	while (__sync_lock_test_and_set(&submission_queue->lock, 1)) {
+		sched_yield();
+	}
+
+	unsigned long sequence = __sync_add_and_fetch(&submission_queue->submitted, 1);
+
+	push_submission(submission_queue, submission);
+
+	__sync_lock_release(&submission_queue->lock);
+
+	/* Only wake the submission thread up if it went to sleep. */
+	if (__sync_bool_compare_and_swap(&submission_queue->sleeping, 1, 0)) {
+		pthread_mutex_lock(&submission_queue->mutex);
+		pthread_cond_signal(&submission_queue->cond);
+		pthread_mutex_unlock(&submission_queue->mutex);
+	}
+
+	return sequence;
+}
+
+/* Same as inclWaitForSubmission, but gives up with ETIMEDOUT once *timeout_usec microseconds have passed, and takes the time waited off *timeout_usec. */
+__attribute__ ((visibility ("hidden")))
+int inclTimedWaitForSubmission(incl_submission_queue submission_queue, unsigned long sequence, unsigned long *timeout_usec) {
+	if (__sync_add_and_fetch(&submission_queue->completed, 0) >= sequence) {
+		return EXIT_SUCCESS;
+	}
+
+	if (!*timeout_usec) {
+		return ETIMEDOUT;
+	}
+
+	struct timespec tp;
+
+	clock_gettime(CLOCK_MONOTONIC, &tp);
+	unsigned long start = SEC_TO_USEC((unsigned long) tp.tv_sec) + NSEC_TO_USEC((unsigned long) tp.tv_nsec);
+
+	struct timespec deadline = tp;
+	deadline.tv_sec += *timeout_usec / SEC_TO_USEC(1);
+	deadline.tv_nsec += USEC_TO_NSEC(*timeout_usec % SEC_TO_USEC(1));
+	if (deadline.tv_nsec >= USEC_TO_NSEC(SEC_TO_USEC(1))) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= USEC_TO_NSEC(SEC_TO_USEC(1));
+	}
+
+	int error = 0;
+
+	pthread_mutex_lock(&submission_queue->mutex);
+	__sync_add_and_fetch(&submission_queue->waiters, 1);
+	while (__sync_add_and_fetch(&submission_queue->completed, 0) < sequence && error != ETIMEDOUT) {
+		error = pthread_cond_timedwait(&submission_queue->idle, &submission_queue->mutex, &deadline);
+	}
+	__sync_sub_and_fetch(&submission_queue->waiters, 1);
+	pthread_mutex_unlock(&submission_queue->mutex);
+
+	clock_gettime(CLOCK_MONOTONIC, &tp);
+	unsigned long stop = SEC_TO_USEC((unsigned long) tp.tv_sec) + NSEC_TO_USEC((unsigned long) tp.tv_nsec);
+
+	*timeout_usec = stop - start < *timeout_usec ? *timeout_usec - (stop - start) : 0;
+
+	return __sync_add_and_fetch(&submission_queue->completed, 0) >= sequence ? EXIT_SUCCESS : ETIMEDOUT;
+}
+
+/* Waits for the submission with the given sequence number, and all the ones before it, to run and get flushed. */
+__attribute__ ((visibility ("hidden")))
+void inclWaitForSubmission(incl_submission_queue submission_queue, unsigned long sequence) {
+	if (__sync_add_and_fetch(&submission_queue->completed, 0) >= sequence) {
+		return;
+	}
+
+	pthread_mutex_lock(&submission_queue->mutex);
+	__sync_add_and_fetch(&submission_queue->waiters, 1);
+	while (__sync_add_and_fetch(&submission_queue->completed, 0) < sequence) {
+		pthread_cond_wait(&submission_queue->idle, &submission_queue->mutex);
+	}
+	__sync_sub_and_fetch(&submission_queue->waiters, 1);
+	pthread_mutex_unlock(&submission_queue->mutex);
+}
+
+/* Waits for all the submissions pushed before the call to run and get flushed. */
+__attribute__ ((visibility ("hidden")))
+void inclWaitForSubmissions(incl_submission_queue submission_queue) {
+	inclWaitForSubmission(submission_queue, __sync_add_and_fetch(&submission_queue->submitted, 0));
+}
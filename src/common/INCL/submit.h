@@ -0,0 +1,29 @@
+#ifndef SUBMIT_H
+#define SUBMIT_H
+
+#include "opencl.h"
+
+typedef struct _incl_submission_queue *incl_submission_queue;
+
+/* Allocates a submission that calls routine with a copy of its size bytes argument, and returns that argument for the caller to fill in. */
+void *inclCreateSubmission(void (*routine)(void *arg), size_t size);
+
+/* Creates a submission queue, along with the thread that runs its submissions in order and calls flush after every batch. */
+incl_submission_queue inclCreateSubmissionQueue(void (*flush)(void *user_data), void *user_data);
+
+/* Runs all pending submissions, then releases the submission queue and its thread. */
+void inclReleaseSubmissionQueue(incl_submission_queue submission_queue);
+
+/* Pushes a submission to the queue, and returns its sequence number. */
+unsigned long inclSubmit(incl_submission_queue submission_queue, void *arg);
+
+/* Same as inclWaitForSubmission, but gives up with ETIMEDOUT once *timeout_usec microseconds have passed, and takes the time waited off *timeout_usec. */
+int inclTimedWaitForSubmission(incl_submission_queue submission_queue, unsigned long sequence, unsigned long *timeout_usec);
+
+/* Waits for the submission with the given sequence number, and all the ones before it, to run and get flushed. */
+void inclWaitForSubmission(incl_submission_queue submission_queue, unsigned long sequence);
+
+/* Waits for all the submissions pushed before the call to run and get flushed. */
+void inclWaitForSubmissions(incl_submission_queue submission_queue);
+
+#endif
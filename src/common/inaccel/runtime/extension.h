@@ -0,0 +1,151 @@
+#ifndef INACCEL_RUNTIME_EXTENSION_H
+#define INACCEL_RUNTIME_EXTENSION_H
+
+#include <inaccel/runtime.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returned by the non-blocking calls while the operation is still in progress. */
+#define INACCEL_PENDING 2
+
+/* Returned by the timed await calls when the timeout expires before the operation completes. */
+#define INACCEL_TIMEDOUT 3
+
+/* Wait policies of the await calls of a resource. */
+#define INACCEL_WAIT_BLOCK 0
+#define INACCEL_WAIT_SPIN 1
+#define INACCEL_WAIT_HYBRID 2
+
+/* Access of the compute units to a buffer: an input they only read, an output they only write, or scratch memory that is never copied to or from host memory. */
+#define INACCEL_BUFFER_READ_WRITE 0
+#define INACCEL_BUFFER_READ_ONLY 1
+#define INACCEL_BUFFER_WRITE_ONLY 2
+#define INACCEL_BUFFER_DEVICE_ONLY 3
+
+/* Host access to a mapped range of a buffer. */
+#define INACCEL_MAP_READ 1
+#define INACCEL_MAP_WRITE 2
+
+/* A region of size bytes at offset of a buffer, and the host memory it is copied from or to. */
+typedef struct _cl_buffer_copy_region {
+	void *host;
+	size_t offset;
+	size_t size;
+} cl_buffer_copy_region;
+
+typedef struct _cl_graph *cl_graph;
+
+typedef struct _cl_pipeline *cl_pipeline;
+
+/* Records a set_compute_unit_arg call in the graph. Scalar values are read from value again on every replay, and only set again if they changed. */
+int add_graph_compute_unit_arg(cl_graph graph, cl_compute_unit compute_unit, unsigned int index, size_t size, const void *value);
+
+/* Records a run_compute_unit call in the graph. */
+int add_graph_compute_unit_run(cl_graph graph, cl_compute_unit compute_unit);
+
+/* Records a copy_from_buffer call in the graph. */
+int add_graph_copy_from_buffer(cl_graph graph, cl_buffer buffer);
+
+/* Records a copy_to_buffer call in the graph. */
+int add_graph_copy_to_buffer(cl_graph graph, cl_buffer buffer);
+
+/* Waits for all the copies and runs of the last replay of the graph. */
+int await_graph_replay(cl_graph graph);
+
+/* Waits for every chunk pushed to the pipeline to complete. */
+int await_pipeline(cl_pipeline pipeline);
+
+/* Copies size bytes from src_offset of the memory of src_buffer to dst_offset of the memory of dst_buffer, on the device of their resource and across memories, without going through host memory. The copy can be awaited through either buffer. */
+int copy_buffer_to_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size);
+
+/* Copies size bytes from src_offset of the memory of src_buffer to dst_offset of the memory of dst_buffer, which may belong to another resource. Between resources, the copy goes straight from device to device where P2P is supported, and otherwise bounces through host memory in chunks, reading one while the previous is written. Returns once the copy is done. */
+int copy_buffer_to_peer_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size);
+
+/* Copies size bytes of the buffer, starting at offset, from its memory to the same range of its host memory. */
+int copy_from_buffer_range(cl_buffer buffer, size_t offset, size_t size);
+
+/* Copies a set of regions of the buffer from its memory to their host memory, as a single copy of the buffer. */
+int copy_from_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions);
+
+/* Copies a set of buffers of the same resource from their memories, as a single batch. */
+int copy_from_buffers(unsigned int num_buffers, const cl_buffer *buffers);
+
+/* Copies size bytes of the host memory of the buffer, starting at offset, to the same range of its memory. */
+int copy_to_buffer_range(cl_buffer buffer, size_t offset, size_t size);
+
+/* Copies a set of regions of the buffer from their host memory to its memory, as a single copy of the buffer. */
+int copy_to_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions);
+
+/* Copies a set of buffers of the same resource to their memories, as a single batch. */
+int copy_to_buffers(unsigned int num_buffers, const cl_buffer *buffers);
+
+/* Creates a buffer like create_buffer, along with the access of the compute units to it, or NULL for an unknown access. Copying a write-only buffer to its memory as a whole only orders it after what came before, leaving its memory as it is, while device-only buffers ignore host and fail to be copied to or from it. */
+cl_buffer create_buffer_with_access(cl_memory memory, size_t size, void *host, int access);
+
+/* Creates an empty graph of copies, argument updates and runs on the buffers and compute units of a resource. */
+cl_graph create_graph(cl_resource resource);
+
+/* Creates a pipeline that streams chunks of up to chunk_size bytes through the compute unit, over depth sets of buffers of input_memory and output_memory bound to its input_index and output_index arguments. Other arguments are left to the caller. */
+cl_pipeline create_pipeline(cl_compute_unit compute_unit, unsigned int input_index, cl_memory input_memory, unsigned int output_index, cl_memory output_memory, size_t chunk_size, unsigned int depth);
+
+/* Fills size bytes of the memory of the buffer, starting at offset, with the pattern_size bytes (1 to 128, a power of two) of pattern, on the device. Both offset and size have to be multiples of pattern_size. Tracked and awaited like a copy of the buffer; its host memory is left untouched. */
+int fill_buffer(cl_buffer buffer, const void *pattern, size_t pattern_size, size_t offset, size_t size);
+
+/* Returns an eventfd that is incremented every time a copy of the buffer completes. */
+int get_buffer_eventfd(cl_buffer buffer);
+
+/* Returns an eventfd that is incremented every time a run of the compute unit completes. */
+int get_compute_unit_eventfd(cl_compute_unit compute_unit);
+
+/* Maps size bytes of the memory of the buffer, starting at offset, to host memory for INACCEL_MAP_READ and/or INACCEL_MAP_WRITE access, once its pending copies and runs are done. Only the mapped range is transferred. */
+void *map_buffer(cl_buffer buffer, int flags, size_t offset, size_t size);
+
+/* Copies size bytes from input to the next set of pipeline buffers, runs the compute unit on them and copies size bytes back to output, overlapping with the chunks before it. Only waits for the chunk pushed depth chunks earlier, whose host memory can then be reused. */
+int push_pipeline_chunk(cl_pipeline pipeline, const void *input, void *output, size_t size);
+
+/* Releases the graph. The buffers and compute units it records are left untouched. */
+void release_graph(cl_graph graph);
+
+/* Releases the pipeline and its buffers. */
+void release_pipeline(cl_pipeline pipeline);
+
+/* Runs the compute unit num_runs times back-to-back, and only tracks the last run. If values is not NULL, the scalar argument index is set to the next size bytes of it before every run. */
+int repeat_compute_unit_run(cl_compute_unit compute_unit, unsigned int num_runs, unsigned int index, size_t size, const void *values);
+
+/* Issues all the calls recorded in the graph, in order, with a single flush. */
+int replay_graph(cl_graph graph);
+
+/* Registers a callback to run, on a runtime-owned thread, once the outstanding copy of the buffer completes. It never runs if the resource is released before that. */
+int set_buffer_copy_callback(cl_buffer buffer, void (*callback)(int error, void *user_data), void *user_data);
+
+/* Sets how many runs of the compute unit can be in flight at once, each on its own kernel instance, up to 64. Waits for the outstanding run first. */
+int set_compute_unit_depth(cl_compute_unit compute_unit, unsigned int depth);
+
+/* Registers a callback to run, on a runtime-owned thread, once the outstanding run of the compute unit completes. It never runs if the resource is released before that. */
+int set_compute_unit_run_callback(cl_compute_unit compute_unit, void (*callback)(int error, void *user_data), void *user_data);
+
+/* Sets whether the awaits on the buffers and compute units of the resource block, spin, or spin for up to spin_usec microseconds and then block. */
+int set_resource_wait_policy(cl_resource resource, int policy, unsigned int spin_usec);
+
+/* Returns immediately whether the outstanding copy of the buffer is done, pending or failed. */
+int test_buffer_copy(cl_buffer buffer);
+
+/* Returns immediately whether the outstanding run of the compute unit is done, pending or failed. */
+int test_compute_unit_run(cl_compute_unit compute_unit);
+
+/* Waits for up to timeout_usec microseconds for the outstanding copy of the buffer; on timeout the copy stays tracked and can be awaited again. */
+int timed_await_buffer_copy(cl_buffer buffer, unsigned long timeout_usec);
+
+/* Waits for up to timeout_usec microseconds for the outstanding run of the compute unit; on timeout the run stays tracked and can be awaited again. */
+int timed_await_compute_unit_run(cl_compute_unit compute_unit, unsigned long timeout_usec);
+
+/* Unmaps a range of the buffer mapped by map_buffer, writing any changes back to its memory. Tracked and awaited like a copy of the buffer. */
+int unmap_buffer(cl_buffer buffer, void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INACCEL_RUNTIME_EXTENSION_H
@@ -146,6 +146,14 @@ void release_resource(cl_resource resource) {
 	LOG_RETURNED("");
 }
 
+int set_resource_wait_policy(cl_resource resource, int policy, unsigned int spin_usec) {
+	LOGGER;
+	LOG(": resource = %p, policy = %d, spin_usec = %u", resource, policy, spin_usec);
+	int error = __inaccel_set_resource_wait_policy(resource, policy, spin_usec);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
 cl_memory create_memory(cl_resource resource, unsigned int index) {
 	LOGGER;
 	LOG(": resource = %p, index = %u", resource, index);
@@ -224,6 +232,142 @@ void release_buffer(cl_buffer buffer) {
 	LOG_RETURNED("");
 }
 
+int get_buffer_eventfd(cl_buffer buffer) {
+	LOGGER;
+	LOG(": buffer = %p", buffer);
+	int fd = __inaccel_get_buffer_eventfd(buffer);
+	LOG_RETURNED(": fd = %d", fd);
+	return fd;
+}
+
+int set_buffer_copy_callback(cl_buffer buffer, void (*callback)(int error, void *user_data), void *user_data) {
+	LOGGER;
+	LOG(": buffer = %p, callback = %p, user_data = %p", buffer, callback, user_data);
+	int error = __inaccel_set_buffer_copy_callback(buffer, callback, user_data);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int test_buffer_copy(cl_buffer buffer) {
+	LOGGER;
+	LOG(": buffer = %p", buffer);
+	int error = __inaccel_test_buffer_copy(buffer);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int timed_await_buffer_copy(cl_buffer buffer, unsigned long timeout_usec) {
+	LOGGER;
+	LOG(": buffer = %p, timeout_usec = %lu", buffer, timeout_usec);
+	int error = __inaccel_timed_await_buffer_copy(buffer, timeout_usec);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int copy_to_buffers(unsigned int num_buffers, const cl_buffer *buffers) {
+	LOGGER;
+	LOG(": num_buffers = %u, buffers = %p", num_buffers, buffers);
+	int error = __inaccel_copy_to_buffers(num_buffers, buffers);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int copy_from_buffers(unsigned int num_buffers, const cl_buffer *buffers) {
+	LOGGER;
+	LOG(": num_buffers = %u, buffers = %p", num_buffers, buffers);
+	int error = __inaccel_copy_from_buffers(num_buffers, buffers);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int copy_to_buffer_range(cl_buffer buffer, size_t offset, size_t size) {
+	LOGGER;
+	LOG(": buffer = %p, offset = %lu, size = %lu", buffer, offset, size);
+	int error = __inaccel_copy_to_buffer_range(buffer, offset, size);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int copy_from_buffer_range(cl_buffer buffer, size_t offset, size_t size) {
+	LOGGER;
+	LOG(": buffer = %p, offset = %lu, size = %lu", buffer, offset, size);
+	int error = __inaccel_copy_from_buffer_range(buffer, offset, size);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int copy_to_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions) {
+	LOGGER;
+	LOG(": buffer = %p, num_regions = %u, regions = %p", buffer, num_regions, regions);
+	int error = __inaccel_copy_to_buffer_regions(buffer, num_regions, regions);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int copy_from_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions) {
+	LOGGER;
+	LOG(": buffer = %p, num_regions = %u, regions = %p", buffer, num_regions, regions);
+	int error = __inaccel_copy_from_buffer_regions(buffer, num_regions, regions);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int copy_buffer_to_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size) {
+	LOGGER;
+	LOG(": src_buffer = %p, dst_buffer = %p, src_offset = %lu, dst_offset = %lu, size = %lu", src_buffer, dst_buffer, src_offset, dst_offset, size);
+	int error = __inaccel_copy_buffer_to_buffer(src_buffer, dst_buffer, src_offset, dst_offset, size);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int copy_buffer_to_peer_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size) {
+	LOGGER;
+	LOG(": src_buffer = %p, dst_buffer = %p, src_offset = %lu, dst_offset = %lu, size = %lu", src_buffer, dst_buffer, src_offset, dst_offset, size);
+	int error = __inaccel_copy_buffer_to_peer_buffer(src_buffer, dst_buffer, src_offset, dst_offset, size);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int fill_buffer(cl_buffer buffer, const void *pattern, size_t pattern_size, size_t offset, size_t size) {
+	LOGGER;
+	LOG(": buffer = %p, pattern = %p, pattern_size = %lu, offset = %lu, size = %lu", buffer, pattern, pattern_size, offset, size);
+	int error = __inaccel_fill_buffer(buffer, pattern, pattern_size, offset, size);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+void *map_buffer(cl_buffer buffer, int flags, size_t offset, size_t size) {
+	LOGGER;
+	LOG(": buffer = %p, flags = %d, offset = %lu, size = %lu", buffer, flags, offset, size);
+	void *ptr = __inaccel_map_buffer(buffer, flags, offset, size);
+	if (ptr == INACCEL_FAILED) {
+		LOG_RETURNED(": ptr = (failed)");
+	} else {
+		LOG_RETURNED(": ptr = %p", ptr);
+	}
+	return ptr;
+}
+
+int unmap_buffer(cl_buffer buffer, void *ptr) {
+	LOGGER;
+	LOG(": buffer = %p, ptr = %p", buffer, ptr);
+	int error = __inaccel_unmap_buffer(buffer, ptr);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+cl_buffer create_buffer_with_access(cl_memory memory, size_t size, void *host, int access) {
+	LOGGER;
+	LOG(": memory = %p, size = %lu, host = %p, access = %d", memory, size, host, access);
+	cl_buffer buffer = __inaccel_create_buffer_with_access(memory, size, host, access);
+	if (buffer == INACCEL_FAILED) {
+		LOG_RETURNED(": buffer = (failed)");
+	} else {
+		LOG_RETURNED(": buffer = %p", buffer);
+	}
+	return buffer;
+}
+
 cl_compute_unit create_compute_unit(cl_resource resource, const char *name) {
 	LOGGER;
 	LOG(": resource = %p, name = %s", resource, name);
@@ -271,4 +415,158 @@ void release_compute_unit(cl_compute_unit compute_unit) {
 	LOG_RETURNED("");
 }
 
+int get_compute_unit_eventfd(cl_compute_unit compute_unit) {
+	LOGGER;
+	LOG(": compute_unit = %p", compute_unit);
+	int fd = __inaccel_get_compute_unit_eventfd(compute_unit);
+	LOG_RETURNED(": fd = %d", fd);
+	return fd;
+}
+
+int set_compute_unit_run_callback(cl_compute_unit compute_unit, void (*callback)(int error, void *user_data), void *user_data) {
+	LOGGER;
+	LOG(": compute_unit = %p, callback = %p, user_data = %p", compute_unit, callback, user_data);
+	int error = __inaccel_set_compute_unit_run_callback(compute_unit, callback, user_data);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int test_compute_unit_run(cl_compute_unit compute_unit) {
+	LOGGER;
+	LOG(": compute_unit = %p", compute_unit);
+	int error = __inaccel_test_compute_unit_run(compute_unit);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int timed_await_compute_unit_run(cl_compute_unit compute_unit, unsigned long timeout_usec) {
+	LOGGER;
+	LOG(": compute_unit = %p, timeout_usec = %lu", compute_unit, timeout_usec);
+	int error = __inaccel_timed_await_compute_unit_run(compute_unit, timeout_usec);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int repeat_compute_unit_run(cl_compute_unit compute_unit, unsigned int num_runs, unsigned int index, size_t size, const void *values) {
+	LOGGER;
+	LOG(": compute_unit = %p, num_runs = %u, index = %u, size = %lu, values = %p", compute_unit, num_runs, index, size, values);
+	int error = __inaccel_repeat_compute_unit_run(compute_unit, num_runs, index, size, values);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int set_compute_unit_depth(cl_compute_unit compute_unit, unsigned int depth) {
+	LOGGER;
+	LOG(": compute_unit = %p, depth = %u", compute_unit, depth);
+	int error = __inaccel_set_compute_unit_depth(compute_unit, depth);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+cl_graph create_graph(cl_resource resource) {
+	LOGGER;
+	LOG(": resource = %p", resource);
+	cl_graph graph = __inaccel_create_graph(resource);
+	if (graph == INACCEL_FAILED) {
+		LOG_RETURNED(": graph = (failed)");
+	} else {
+		LOG_RETURNED(": graph = %p", graph);
+	}
+	return graph;
+}
+
+int add_graph_copy_to_buffer(cl_graph graph, cl_buffer buffer) {
+	LOGGER;
+	LOG(": graph = %p, buffer = %p", graph, buffer);
+	int error = __inaccel_add_graph_copy_to_buffer(graph, buffer);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int add_graph_compute_unit_arg(cl_graph graph, cl_compute_unit compute_unit, unsigned int index, size_t size, const void *value) {
+	LOGGER;
+	if (size) {
+		LOG(": graph = %p, compute_unit = %p, index = %u, size = %lu, value = %p", graph, compute_unit, index, size, value);
+	} else {
+		LOG(": graph = %p, compute_unit = %p, index = %u, buffer = %p", graph, compute_unit, index, value);
+	}
+	int error = __inaccel_add_graph_compute_unit_arg(graph, compute_unit, index, size, value);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int add_graph_compute_unit_run(cl_graph graph, cl_compute_unit compute_unit) {
+	LOGGER;
+	LOG(": graph = %p, compute_unit = %p", graph, compute_unit);
+	int error = __inaccel_add_graph_compute_unit_run(graph, compute_unit);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int add_graph_copy_from_buffer(cl_graph graph, cl_buffer buffer) {
+	LOGGER;
+	LOG(": graph = %p, buffer = %p", graph, buffer);
+	int error = __inaccel_add_graph_copy_from_buffer(graph, buffer);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int replay_graph(cl_graph graph) {
+	LOGGER;
+	LOG(": graph = %p", graph);
+	int error = __inaccel_replay_graph(graph);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int await_graph_replay(cl_graph graph) {
+	LOGGER;
+	LOG(": graph = %p", graph);
+	int error = __inaccel_await_graph_replay(graph);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+void release_graph(cl_graph graph) {
+	LOGGER;
+	LOG(": graph = %p", graph);
+	__inaccel_release_graph(graph);
+	LOG_RETURNED("");
+}
+
+cl_pipeline create_pipeline(cl_compute_unit compute_unit, unsigned int input_index, cl_memory input_memory, unsigned int output_index, cl_memory output_memory, size_t chunk_size, unsigned int depth) {
+	LOGGER;
+	LOG(": compute_unit = %p, input_index = %u, input_memory = %p, output_index = %u, output_memory = %p, chunk_size = %lu, depth = %u", compute_unit, input_index, input_memory, output_index, output_memory, chunk_size, depth);
+	cl_pipeline pipeline = __inaccel_create_pipeline(compute_unit, input_index, input_memory, output_index, output_memory, chunk_size, depth);
+	if (pipeline == INACCEL_FAILED) {
+		LOG_RETURNED(": pipeline = (failed)");
+	} else {
+		LOG_RETURNED(": pipeline = %p", pipeline);
+	}
+	return pipeline;
+}
+
+int push_pipeline_chunk(cl_pipeline pipeline, const void *input, void *output, size_t size) {
+	LOGGER;
+	LOG(": pipeline = %p, input = %p, output = %p, size = %lu", pipeline, input, output, size);
+	int error = __inaccel_push_pipeline_chunk(pipeline, input, output, size);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+int await_pipeline(cl_pipeline pipeline) {
+	LOGGER;
+	LOG(": pipeline = %p", pipeline);
+	int error = __inaccel_await_pipeline(pipeline);
+	LOG_RETURNED(": error = %d", error);
+	return error;
+}
+
+void release_pipeline(cl_pipeline pipeline) {
+	LOGGER;
+	LOG(": pipeline = %p", pipeline);
+	__inaccel_release_pipeline(pipeline);
+	LOG_RETURNED("");
+}
+
 #endif
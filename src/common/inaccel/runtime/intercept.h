@@ -67,6 +67,11 @@ __attribute__ ((weak, alias("release_resource"), visibility ("hidden")))
 #endif
 void __inaccel_release_resource(cl_resource resource);
 
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("set_resource_wait_policy"), visibility ("hidden")))
+#endif
+int __inaccel_set_resource_wait_policy(cl_resource resource, int policy, unsigned int spin_usec);
+
 #ifndef INACCEL_RUNTIME_H
 typedef struct _cl_memory *cl_memory;
 #endif
@@ -120,6 +125,90 @@ __attribute__ ((weak, alias("release_buffer"), visibility ("hidden")))
 #endif
 void __inaccel_release_buffer(cl_buffer buffer);
 
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("get_buffer_eventfd"), visibility ("hidden")))
+#endif
+int __inaccel_get_buffer_eventfd(cl_buffer buffer);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("set_buffer_copy_callback"), visibility ("hidden")))
+#endif
+int __inaccel_set_buffer_copy_callback(cl_buffer buffer, void (*callback)(int error, void *user_data), void *user_data);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("test_buffer_copy"), visibility ("hidden")))
+#endif
+int __inaccel_test_buffer_copy(cl_buffer buffer);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("timed_await_buffer_copy"), visibility ("hidden")))
+#endif
+int __inaccel_timed_await_buffer_copy(cl_buffer buffer, unsigned long timeout_usec);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("copy_to_buffers"), visibility ("hidden")))
+#endif
+int __inaccel_copy_to_buffers(unsigned int num_buffers, const cl_buffer *buffers);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("copy_from_buffers"), visibility ("hidden")))
+#endif
+int __inaccel_copy_from_buffers(unsigned int num_buffers, const cl_buffer *buffers);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("copy_to_buffer_range"), visibility ("hidden")))
+#endif
+int __inaccel_copy_to_buffer_range(cl_buffer buffer, size_t offset, size_t size);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("copy_from_buffer_range"), visibility ("hidden")))
+#endif
+int __inaccel_copy_from_buffer_range(cl_buffer buffer, size_t offset, size_t size);
+
+#ifndef INACCEL_RUNTIME_EXTENSION_H
+typedef struct _cl_buffer_copy_region cl_buffer_copy_region;
+#endif
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("copy_to_buffer_regions"), visibility ("hidden")))
+#endif
+int __inaccel_copy_to_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("copy_from_buffer_regions"), visibility ("hidden")))
+#endif
+int __inaccel_copy_from_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("copy_buffer_to_buffer"), visibility ("hidden")))
+#endif
+int __inaccel_copy_buffer_to_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("copy_buffer_to_peer_buffer"), visibility ("hidden")))
+#endif
+int __inaccel_copy_buffer_to_peer_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("fill_buffer"), visibility ("hidden")))
+#endif
+int __inaccel_fill_buffer(cl_buffer buffer, const void *pattern, size_t pattern_size, size_t offset, size_t size);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("map_buffer"), visibility ("hidden")))
+#endif
+void *__inaccel_map_buffer(cl_buffer buffer, int flags, size_t offset, size_t size);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("unmap_buffer"), visibility ("hidden")))
+#endif
+int __inaccel_unmap_buffer(cl_buffer buffer, void *ptr);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("create_buffer_with_access"), visibility ("hidden")))
+#endif
+cl_buffer __inaccel_create_buffer_with_access(cl_memory memory, size_t size, void *host, int access);
+
 #ifndef INACCEL_RUNTIME_H
 typedef struct _cl_compute_unit *cl_compute_unit;
 #endif
@@ -149,6 +238,104 @@ __attribute__ ((weak, alias("release_compute_unit"), visibility ("hidden")))
 #endif
 void __inaccel_release_compute_unit(cl_compute_unit compute_unit);
 
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("get_compute_unit_eventfd"), visibility ("hidden")))
+#endif
+int __inaccel_get_compute_unit_eventfd(cl_compute_unit compute_unit);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("set_compute_unit_run_callback"), visibility ("hidden")))
+#endif
+int __inaccel_set_compute_unit_run_callback(cl_compute_unit compute_unit, void (*callback)(int error, void *user_data), void *user_data);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("test_compute_unit_run"), visibility ("hidden")))
+#endif
+int __inaccel_test_compute_unit_run(cl_compute_unit compute_unit);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("timed_await_compute_unit_run"), visibility ("hidden")))
+#endif
+int __inaccel_timed_await_compute_unit_run(cl_compute_unit compute_unit, unsigned long timeout_usec);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("repeat_compute_unit_run"), visibility ("hidden")))
+#endif
+int __inaccel_repeat_compute_unit_run(cl_compute_unit compute_unit, unsigned int num_runs, unsigned int index, size_t size, const void *values);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("set_compute_unit_depth"), visibility ("hidden")))
+#endif
+int __inaccel_set_compute_unit_depth(cl_compute_unit compute_unit, unsigned int depth);
+
+#ifndef INACCEL_RUNTIME_EXTENSION_H
+typedef struct _cl_graph *cl_graph;
+#endif
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("create_graph"), visibility ("hidden")))
+#endif
+cl_graph __inaccel_create_graph(cl_resource resource);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("add_graph_copy_to_buffer"), visibility ("hidden")))
+#endif
+int __inaccel_add_graph_copy_to_buffer(cl_graph graph, cl_buffer buffer);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("add_graph_compute_unit_arg"), visibility ("hidden")))
+#endif
+int __inaccel_add_graph_compute_unit_arg(cl_graph graph, cl_compute_unit compute_unit, unsigned int index, size_t size, const void *value);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("add_graph_compute_unit_run"), visibility ("hidden")))
+#endif
+int __inaccel_add_graph_compute_unit_run(cl_graph graph, cl_compute_unit compute_unit);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("add_graph_copy_from_buffer"), visibility ("hidden")))
+#endif
+int __inaccel_add_graph_copy_from_buffer(cl_graph graph, cl_buffer buffer);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("replay_graph"), visibility ("hidden")))
+#endif
+int __inaccel_replay_graph(cl_graph graph);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("await_graph_replay"), visibility ("hidden")))
+#endif
+int __inaccel_await_graph_replay(cl_graph graph);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("release_graph"), visibility ("hidden")))
+#endif
+void __inaccel_release_graph(cl_graph graph);
+
+#ifndef INACCEL_RUNTIME_EXTENSION_H
+typedef struct _cl_pipeline *cl_pipeline;
+#endif
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("create_pipeline"), visibility ("hidden")))
+#endif
+cl_pipeline __inaccel_create_pipeline(cl_compute_unit compute_unit, unsigned int input_index, cl_memory input_memory, unsigned int output_index, cl_memory output_memory, size_t chunk_size, unsigned int depth);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("push_pipeline_chunk"), visibility ("hidden")))
+#endif
+int __inaccel_push_pipeline_chunk(cl_pipeline pipeline, const void *input, void *output, size_t size);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("await_pipeline"), visibility ("hidden")))
+#endif
+int __inaccel_await_pipeline(cl_pipeline pipeline);
+
+#ifdef INACCEL_RUNTIME_H
+__attribute__ ((weak, alias("release_pipeline"), visibility ("hidden")))
+#endif
+void __inaccel_release_pipeline(cl_pipeline pipeline);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,3 +1,3 @@
-intel-fpga = inaccel/runtime/intercept INCL/opencl runtime
+intel-fpga = inaccel/runtime/intercept INCL/buddy INCL/cache INCL/event INCL/opencl INCL/pool INCL/submit runtime
 intel-fpga_CFLAGS = -O3 -Wall -DNDEBUG -fPIC
 intel-fpga_LDFLAGS = -shared -Wl,--allow-multiple-definition
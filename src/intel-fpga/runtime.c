@@ -1,23 +1,59 @@
+#include <errno.h>
 #include <glob.h>
 #include <inaccel/runtime.h>
 #include <libgen.h>
 #include <limits.h>
 #include <pthread.h>
 #include <regex.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 
+#include "inaccel/runtime/extension.h"
 #include "inaccel/runtime/intercept.h"
+#include "INCL/buddy.h"
+#include "INCL/cache.h"
+#include "INCL/event.h"
 #include "INCL/opencl.h"
+#include "INCL/pool.h"
+#include "INCL/submit.h"
+
+/* Alignment of the host memory that the Intel FPGA runtime can use in place. */
+#define AOCL_ALIGNMENT 64
+
+/* Size of the chunks of copies between resources, unless INACCEL_COPY_CHUNK_SIZE is set. */
+#define DEFAULT_PEER_CHUNK_SIZE (4 << 20)
+
+/* Largest number of kernel instances that a compute unit keeps in flight. */
+#define MAX_COMPUTE_UNIT_DEPTH 64
+
+/* Largest pattern that OpenCL fills buffers with. */
+#define MAX_FILL_PATTERN_SIZE 128
 
 struct _cl_buffer {
 	cl_memory memory;
 	size_t size;
 	void *host;
+	int access;
 
 	cl_command_queue command_queue;
+	cl_event event;
+	unsigned char error;
+	/* Sequence number of the last submission of the buffer, while submissions are async. */
+	unsigned long submission;
+	incl_eventfd eventfd;
+	cl_event run_event;
 	cl_mem mem;
+	/* Set if mem is backed by the host memory of the buffer. */
+	unsigned char zero_copy;
+	/* Set if mem is a region of the arena of the memory, starting at offset. */
+	unsigned char sub_buffer;
+	size_t offset;
+	/* Size of mem, which is rounded up to a power of two while buffers are cached. */
+	size_t mem_size;
+	/* Generation of the context that mem was created on. */
+	unsigned int generation;
 };
 
 struct _cl_compute_unit {
@@ -25,7 +61,33 @@ struct _cl_compute_unit {
 	char *name;
 
 	cl_command_queue command_queue;
+	unsigned char out_of_order;
+	cl_event event;
+	unsigned char error;
+	/* Sequence number of the last submission of the compute unit, while submissions are async. */
+	unsigned long submission;
+	incl_eventfd eventfd;
 	cl_kernel kernel;
+
+	/* Ring of kernel instances, so that a run can be enqueued while the previous ones are still in flight. */
+	unsigned int depth;
+	unsigned int next;
+	cl_kernel *kernel_ring;
+	cl_event *run_event;
+
+	unsigned int num_args;
+	struct graph_node **arg_node;
+	struct kernel_arg *kernel_arg;
+	unsigned long *kernel_arg_version;
+	cl_buffer *buffer;
+	cl_event *event_wait_list;
+};
+
+struct _cl_graph {
+	cl_resource resource;
+
+	unsigned int num_nodes;
+	struct graph_node **node;
 };
 
 struct _cl_memory {
@@ -34,6 +96,34 @@ struct _cl_memory {
 
 	size_t size;
 	char *type;
+
+	/* Optional buffer that the other buffers of the memory are carved out of. */
+	cl_buffer arena;
+	incl_buddy_allocator buddy_allocator;
+
+	/* Optional cache of released buffers, for new ones to reuse. */
+	incl_mem_cache mem_cache;
+
+	/* Generation of the context that the arena and cache were created on, along with what it takes to create them again on a new one. */
+	unsigned int generation;
+	size_t arena_size;
+	size_t mem_cache_budget;
+	unsigned int num_regions;
+};
+
+struct _cl_pipeline {
+	cl_compute_unit compute_unit;
+	unsigned int input_index;
+	unsigned int output_index;
+	size_t chunk_size;
+
+	/* Chunks take turns on depth sets of input and output buffers. */
+	unsigned int depth;
+	unsigned int next;
+	unsigned int num_pending;
+	cl_buffer *input;
+	cl_buffer *output;
+	unsigned char error;
 };
 
 struct _cl_resource {
@@ -52,11 +142,234 @@ struct _cl_resource {
 	cl_platform_id platform_id;
 	cl_program program;
 
+	incl_command_queue_pool command_queue_pool;
+	/* Bumped whenever reprogramming replaces the context. */
+	unsigned int generation;
+	incl_completion_queue completion_queue;
+	incl_submission_queue submission_queue;
+	unsigned long wait_spin_usec;
+	size_t copy_chunk_size;
+
 	pthread_t thread;
 	unsigned char release;
 	char *root_path;
 };
 
+struct buffer_copy {
+	cl_buffer src_buffer;
+	cl_buffer dst_buffer;
+	size_t src_offset;
+	size_t dst_offset;
+	size_t size;
+};
+
+struct buffer_fill {
+	cl_buffer buffer;
+	size_t offset;
+	size_t size;
+	size_t pattern_size;
+	char pattern[MAX_FILL_PATTERN_SIZE];
+};
+
+struct buffer_list {
+	unsigned int num_buffers;
+	cl_buffer buffer[0];
+};
+
+struct buffer_range {
+	cl_buffer buffer;
+	size_t offset;
+	size_t size;
+};
+
+struct buffer_regions {
+	cl_buffer buffer;
+	unsigned int num_regions;
+	cl_buffer_copy_region region[0];
+};
+
+struct compute_unit_arg {
+	cl_compute_unit compute_unit;
+	unsigned int index;
+	size_t size;
+	const void *value;
+};
+
+struct compute_unit_runs {
+	cl_compute_unit compute_unit;
+	unsigned int num_runs;
+	unsigned int index;
+	size_t size;
+	const void *values;
+};
+
+enum graph_node_type {
+	GRAPH_NODE_COMPUTE_UNIT_ARG,
+	GRAPH_NODE_COMPUTE_UNIT_RUN,
+	GRAPH_NODE_COPY_FROM_BUFFER,
+	GRAPH_NODE_COPY_TO_BUFFER
+};
+
+struct graph_node {
+	enum graph_node_type type;
+
+	cl_buffer buffer;
+	cl_compute_unit compute_unit;
+
+	unsigned int index;
+	size_t size;
+	const void *value;
+	/* Scalar value this node last set, valid while the node still owns the argument. */
+	void *last;
+};
+
+struct kernel_arg {
+	size_t size;
+	void *value;
+	unsigned long version;
+};
+
+struct pipeline_chunk {
+	cl_pipeline pipeline;
+	unsigned int slot;
+	const void *input;
+	void *output;
+	size_t size;
+};
+
+static int apply_compute_unit_arg(cl_compute_unit compute_unit, unsigned int index, size_t size, const void *value) {
+	if (inclSetKernelArg(compute_unit->kernel, index, size, value)) {
+		return EXIT_FAILURE;
+	}
+
+	/* Keep a copy for the other kernel instances, to catch up on once their turn comes. */
+	struct kernel_arg *kernel_arg = &compute_unit->kernel_arg[index];
+	if (kernel_arg->size != size) {
+		void *kernel_arg_value = realloc(kernel_arg->value, size);
+		if (!kernel_arg_value) {
+			perror("Error: realloc");
+
+			return EXIT_FAILURE;
+		}
+		kernel_arg->value = kernel_arg_value;
+		kernel_arg->size = size;
+	}
+	memcpy(kernel_arg->value, value, size);
+	kernel_arg->version++;
+
+	if (compute_unit->depth > 1) {
+		compute_unit->kernel_arg_version[compute_unit->next * compute_unit->num_args + index] = kernel_arg->version;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static cl_buffer create_device_buffer(cl_memory memory, size_t size) {
+	cl_buffer buffer = create_buffer(memory, size, NULL);
+	if (buffer == INACCEL_FAILED) {
+		return NULL;
+	}
+
+	return buffer;
+}
+
+static struct graph_node *create_graph_node(cl_graph graph, enum graph_node_type type) {
+	struct graph_node **node = (struct graph_node **) realloc(graph->node, (graph->num_nodes + 1) * sizeof(struct graph_node *));
+	if (!node) {
+		perror("Error: realloc");
+
+		return NULL;
+	}
+	graph->node = node;
+
+	if (!(graph->node[graph->num_nodes] = (struct graph_node *) calloc(1, sizeof(struct graph_node)))) {
+		perror("Error: calloc");
+
+		return NULL;
+	}
+	graph->node[graph->num_nodes]->type = type;
+
+	return graph->node[graph->num_nodes++];
+}
+
+static int enqueue_copy_chunk(cl_buffer buffer, cl_command_queue command_queue, cl_map_flags map_flags, size_t offset, size_t size, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) {
+	if (buffer->zero_copy) {
+		/* Mapping and unmapping a buffer backed by its host memory moves the contents without staging them. */
+		cl_event map_event;
+		void *ptr = inclEnqueueMapBuffer(command_queue, buffer->mem, CL_FALSE, map_flags, offset, size, num_events_in_wait_list, event_wait_list, &map_event);
+		if (!ptr) {
+			return EXIT_FAILURE;
+		}
+
+		int error = inclEnqueueUnmapMemObject(command_queue, buffer->mem, ptr, 1, &map_event, event);
+
+		inclReleaseEvent(map_event);
+
+		return error;
+	} else if (map_flags & CL_MAP_READ) {
+		return inclEnqueueReadBuffer(command_queue, buffer->mem, offset, size, (char *) buffer->host + offset, num_events_in_wait_list, event_wait_list, event);
+	} else {
+		return inclEnqueueWriteBuffer(command_queue, buffer->mem, offset, size, (char *) buffer->host + offset, num_events_in_wait_list, event_wait_list, event);
+	}
+}
+
+static void flush_routine(void *user_data) {
+	cl_resource resource = (cl_resource) user_data;
+
+	inclFlushCommandQueuePool(resource->command_queue_pool);
+}
+
+static cl_mem_flags get_buffer_mem_flags(cl_buffer buffer) {
+	/* Cached buffers may be reused with another access, so they are left readable and writable. */
+	if (buffer->memory->mem_cache) {
+		return CL_MEM_READ_WRITE;
+	}
+
+	switch (buffer->access) {
+		case INACCEL_BUFFER_READ_ONLY:
+			return CL_MEM_READ_ONLY;
+		case INACCEL_BUFFER_WRITE_ONLY:
+			return CL_MEM_WRITE_ONLY;
+		default:
+			return CL_MEM_READ_WRITE;
+	}
+}
+
+static cl_uint get_buffer_wait_list(cl_buffer buffer, cl_event *event_wait_list) {
+	cl_uint num_events_in_wait_list = 0;
+
+	if (buffer->event) {
+		event_wait_list[num_events_in_wait_list++] = buffer->event;
+	}
+	if (buffer->run_event) {
+		event_wait_list[num_events_in_wait_list++] = buffer->run_event;
+	}
+
+	return num_events_in_wait_list;
+}
+
+static cl_uint get_compute_unit_wait_list(cl_compute_unit compute_unit) {
+	cl_uint num_events_in_wait_list = 0;
+
+	if (compute_unit->depth > 1) {
+		/* Only the run that last used the same kernel instance has to complete first. */
+		if (compute_unit->run_event[compute_unit->next]) {
+			compute_unit->event_wait_list[num_events_in_wait_list++] = compute_unit->run_event[compute_unit->next];
+		}
+	} else if (compute_unit->event) {
+		compute_unit->event_wait_list[num_events_in_wait_list++] = compute_unit->event;
+	}
+
+	unsigned int index;
+	for (index = 0; index < compute_unit->num_args; index++) {
+		if (compute_unit->buffer[index]) {
+			num_events_in_wait_list += get_buffer_wait_list(compute_unit->buffer[index], compute_unit->event_wait_list + num_events_in_wait_list);
+		}
+	}
+
+	return num_events_in_wait_list;
+}
+
 static float get_power_1(char *spi_path) {
 	char sensor_pattern[PATH_MAX];
 	if (sprintf(sensor_pattern, "%s/sensor*", spi_path) < 0) {
@@ -531,606 +844,2751 @@ static void *sensor_routine(void *arg) {
 	return NULL;
 }
 
-int await_buffer_copy(cl_buffer buffer) {
-	return inclFinish(buffer->command_queue);
-}
+static void reserve_memory_arena(cl_memory memory, size_t size) {
+	/* Regions are aligned as sub-buffers have to be, and are at least a page long. */
+	cl_uint mem_base_addr_align;
+	if (inclGetDeviceInfo(memory->resource->device_id, CL_DEVICE_MEM_BASE_ADDR_ALIGN, sizeof(cl_uint), &mem_base_addr_align, NULL)) {
+		return;
+	}
 
-int await_compute_unit_run(cl_compute_unit compute_unit) {
-	return inclFinish(compute_unit->command_queue);
-}
+	size_t min_block_size = mem_base_addr_align / 8 > 4096 ? mem_base_addr_align / 8 : 4096;
+	if (size < min_block_size) {
+		return;
+	}
 
-int copy_from_buffer(cl_buffer buffer) {
-	return inclEnqueueReadBuffer(buffer->command_queue, buffer->mem, 0, buffer->size, buffer->host);
-}
+	size_t arena_size = min_block_size;
+	while (arena_size <= size / 2) {
+		arena_size *= 2;
+	}
 
-int copy_to_buffer(cl_buffer buffer) {
-	return inclEnqueueWriteBuffer(buffer->command_queue, buffer->mem, 0, buffer->size, buffer->host);
+	if (!(memory->arena = create_device_buffer(memory, arena_size))) {
+		return;
+	}
+
+	if (!(memory->buddy_allocator = inclCreateBuddyAllocator(arena_size, min_block_size))) {
+		release_buffer(memory->arena);
+		memory->arena = NULL;
+	}
 }
 
-cl_buffer create_buffer(cl_memory memory, size_t size, void *host) {
-	cl_buffer buffer = (cl_buffer) calloc(1, sizeof(struct _cl_buffer));
-	if (!buffer) {
-		perror("Error: calloc");
+/* Creates the arena and cache of the memory again on the current context of its resource, once reprogramming replaced the one they were created on. Fails while regions of the old arena are still in use. */
+static int refresh_memory(cl_memory memory) {
+	if (memory->generation == memory->resource->generation) {
+		return EXIT_SUCCESS;
+	}
 
-		return INACCEL_FAILED;
+	if (memory->num_regions) {
+		return EXIT_FAILURE;
 	}
 
-	buffer->memory = memory;
-	buffer->size = size;
-	buffer->host = host;
+	if (memory->buddy_allocator) {
+		inclReleaseBuddyAllocator(memory->buddy_allocator);
+		memory->buddy_allocator = NULL;
 
-	if (!(buffer->mem = inclCreateBuffer(memory->resource->context, CL_MEM_READ_WRITE, buffer->size, NULL))) {
-		free(buffer);
+		release_buffer(memory->arena);
+		memory->arena = NULL;
+	}
+	if (memory->mem_cache) {
+		inclReleaseMemCache(memory->mem_cache);
+		memory->mem_cache = NULL;
+	}
 
-		return NULL;
+	/* Up to date before the arena is reserved, since that creates a buffer of the memory itself. */
+	memory->generation = memory->resource->generation;
+
+	if (memory->mem_cache_budget) {
+		memory->mem_cache = inclCreateMemCache(memory->mem_cache_budget);
+	}
+	if (memory->arena_size) {
+		reserve_memory_arena(memory, memory->arena_size);
 	}
 
-	if (!(buffer->command_queue = inclCreateCommandQueue(memory->resource->context, memory->resource->device_id))) {
-		inclReleaseMemObject(buffer->mem);
+	return EXIT_SUCCESS;
+}
 
-		free(buffer);
+static int rotate_compute_unit_kernel(cl_compute_unit compute_unit) {
+	compute_unit->next = (compute_unit->next + 1) % compute_unit->depth;
+	compute_unit->kernel = compute_unit->kernel_ring[compute_unit->next];
 
-		return INACCEL_FAILED;
+	unsigned long *kernel_arg_version = compute_unit->kernel_arg_version + compute_unit->next * compute_unit->num_args;
+
+	unsigned int index;
+	for (index = 0; index < compute_unit->num_args; index++) {
+		if (kernel_arg_version[index] != compute_unit->kernel_arg[index].version) {
+			if (inclSetKernelArg(compute_unit->kernel, index, compute_unit->kernel_arg[index].size, compute_unit->kernel_arg[index].value)) {
+				return EXIT_FAILURE;
+			}
+			kernel_arg_version[index] = compute_unit->kernel_arg[index].version;
+		}
 	}
 
-	return buffer;
+	return EXIT_SUCCESS;
 }
 
-cl_compute_unit create_compute_unit(cl_resource resource, const char *name) {
-	cl_compute_unit compute_unit = (cl_compute_unit) calloc(1, sizeof(struct _cl_compute_unit));
-	if (!compute_unit) {
-		perror("Error: calloc");
-
-		return INACCEL_FAILED;
+static void set_buffer_event(cl_buffer buffer, cl_event event) {
+	if (buffer->event) {
+		inclReleaseEvent(buffer->event);
 	}
+	buffer->event = event;
 
-	compute_unit->resource = resource;
-	if (!(compute_unit->name = strdup(name))) {
-		perror("Error: strdup");
+	if (buffer->eventfd) {
+		inclSignalEventfd(buffer->eventfd, buffer->event);
+	}
+}
 
-		free(compute_unit);
+static void set_buffer_run_event(cl_buffer buffer, cl_event event) {
+	if (buffer->run_event) {
+		inclReleaseEvent(buffer->run_event);
+	}
+	inclRetainEvent(event);
+	buffer->run_event = event;
+}
 
-		return INACCEL_FAILED;
+static int set_compute_unit_event(cl_compute_unit compute_unit, cl_event event) {
+	/* Kernel arguments persist across enqueues, so every bound buffer is used by this run. */
+	unsigned int index;
+	for (index = 0; index < compute_unit->num_args; index++) {
+		if (compute_unit->buffer[index]) {
+			set_buffer_run_event(compute_unit->buffer[index], event);
+		}
 	}
 
-	if (!(compute_unit->kernel = inclCreateKernel(resource->program, compute_unit->name))) {
-		free(compute_unit->name);
-		free(compute_unit);
+	if (compute_unit->depth > 1) {
+		if (compute_unit->run_event[compute_unit->next]) {
+			inclReleaseEvent(compute_unit->run_event[compute_unit->next]);
+		}
+		compute_unit->run_event[compute_unit->next] = event;
 
-		return NULL;
+		if (compute_unit->out_of_order) {
+			/* Runs of different kernel instances may complete out of order, so await them all behind a marker. */
+			cl_uint num_events_in_wait_list = 0;
+
+			unsigned int i;
+			for (i = 0; i < compute_unit->depth; i++) {
+				if (compute_unit->run_event[i]) {
+					compute_unit->event_wait_list[num_events_in_wait_list++] = compute_unit->run_event[i];
+				}
+			}
+
+			if (inclEnqueueMarkerWithWaitList(compute_unit->command_queue, num_events_in_wait_list, compute_unit->event_wait_list, &event)) {
+				return EXIT_FAILURE;
+			}
+		} else {
+			inclRetainEvent(event);
+		}
 	}
 
-	if (!(compute_unit->command_queue = inclCreateCommandQueue(resource->context, resource->device_id))) {
-		inclReleaseKernel(compute_unit->kernel);
+	if (compute_unit->event) {
+		inclReleaseEvent(compute_unit->event);
+	}
+	compute_unit->event = event;
 
-		free(compute_unit->name);
-		free(compute_unit);
+	if (compute_unit->eventfd) {
+		inclSignalEventfd(compute_unit->eventfd, compute_unit->event);
+	}
 
-		return INACCEL_FAILED;
+	if (compute_unit->depth > 1) {
+		return rotate_compute_unit_kernel(compute_unit);
 	}
 
-	return compute_unit;
+	return EXIT_SUCCESS;
 }
 
-cl_memory create_memory(cl_resource resource, unsigned int index) {
-	if (!index) {
-		cl_memory memory = (cl_memory) calloc(1, sizeof(struct _cl_memory));
-		if (!memory) {
-			perror("Error: calloc");
+static int submit_buffer_marker(cl_buffer buffer) {
+	cl_event event_wait_list[2];
+	cl_uint num_events_in_wait_list = get_buffer_wait_list(buffer, event_wait_list);
 
-			return INACCEL_FAILED;
-		}
+	cl_event event;
+	if (inclEnqueueMarkerWithWaitList(buffer->command_queue, num_events_in_wait_list, event_wait_list, &event)) {
+		return EXIT_FAILURE;
+	}
 
-		memory->resource = resource;
-		memory->index = index;
+	set_buffer_event(buffer, event);
 
-		if (inclGetDeviceInfo(resource->device_id, CL_DEVICE_GLOBAL_MEM_SIZE, sizeof(size_t), &memory->size, NULL)) {
-			free(memory);
+	return EXIT_SUCCESS;
+}
 
-			return INACCEL_FAILED;
+static int submit_compute_unit_arg(cl_compute_unit compute_unit, unsigned int index, size_t size, const void *value) {
+	if (index >= compute_unit->num_args) {
+		return EXIT_FAILURE;
+	}
+
+	compute_unit->arg_node[index] = NULL;
+
+	if (size) {
+		if (apply_compute_unit_arg(compute_unit, index, size, value)) {
+			return EXIT_FAILURE;
 		}
 
-		if (!(memory->type = strdup("DDR"))) {
-			perror("Error: strdup");
+		compute_unit->buffer[index] = NULL;
 
-			free(memory);
+		return EXIT_SUCCESS;
+	} else {
+		cl_buffer buffer = (cl_buffer) value;
 
-			return INACCEL_FAILED;
+		if (apply_compute_unit_arg(compute_unit, index, sizeof(cl_mem), &buffer->mem)) {
+			return EXIT_FAILURE;
 		}
 
-		return memory;
+		compute_unit->buffer[index] = buffer;
+
+		return EXIT_SUCCESS;
 	}
-	return NULL;
 }
 
-cl_resource create_resource(unsigned int index) {
-	cl_resource resource = (cl_resource) calloc(1, sizeof(struct _cl_resource));
-	if (!resource) {
-		perror("Error: calloc");
+static void submit_compute_unit_arg_routine(void *arg) {
+	struct compute_unit_arg *compute_unit_arg = (struct compute_unit_arg *) arg;
 
-		return INACCEL_FAILED;
+	if (submit_compute_unit_arg(compute_unit_arg->compute_unit, compute_unit_arg->index, compute_unit_arg->size, compute_unit_arg->value)) {
+		compute_unit_arg->compute_unit->error = 1;
 	}
+}
 
-	resource->index = index;
+static int submit_copy_buffer(cl_buffer buffer, cl_map_flags map_flags, size_t offset, size_t size) {
+	cl_event event_wait_list[2];
+	cl_uint num_events_in_wait_list = get_buffer_wait_list(buffer, event_wait_list);
 
-	if (!(resource->platform_id = inclGetPlatformID("Intel"))) {
-		free(resource);
+	cl_resource resource = buffer->memory->resource;
 
-		return NULL;
-	}
+	cl_event event;
+	/* The command-queues of the pool are of the current context, which buffers created before a reprogram are not. */
+	if (!resource->copy_chunk_size || size <= resource->copy_chunk_size || buffer->generation != resource->generation) {
+		if (enqueue_copy_chunk(buffer, buffer->command_queue, map_flags, offset, size, num_events_in_wait_list, event_wait_list, &event)) {
+			return EXIT_FAILURE;
+		}
+	} else {
+		/* Large copies are split in chunks, spread over the command-queues of the pool, and tracked as one behind a marker. */
+		unsigned int num_chunks = (size + resource->copy_chunk_size - 1) / resource->copy_chunk_size;
 
-	if (!(resource->device_id = inclGetDeviceID(resource->platform_id, resource->index))) {
-		free(resource);
+		cl_event *chunk_events = (cl_event *) calloc(num_chunks, sizeof(cl_event));
+		if (!chunk_events) {
+			perror("Error: calloc");
 
-		return NULL;
-	}
+			return EXIT_FAILURE;
+		}
 
-	if (!(resource->context = inclCreateContext(resource->device_id))) {
-		free(resource);
+		unsigned int chunk;
+		for (chunk = 0; chunk < num_chunks; chunk++) {
+			size_t chunk_offset = chunk * resource->copy_chunk_size;
+			size_t chunk_size = size - chunk_offset < resource->copy_chunk_size ? size - chunk_offset : resource->copy_chunk_size;
 
-		return INACCEL_FAILED;
-	}
+			if (enqueue_copy_chunk(buffer, inclGetCommandQueue(resource->command_queue_pool, chunk), map_flags, offset + chunk_offset, chunk_size, num_events_in_wait_list, event_wait_list, &chunk_events[chunk])) {
+				while (chunk--) {
+					inclReleaseEvent(chunk_events[chunk]);
+				}
 
-	if (!(resource->vendor = strdup("intel"))) {
-		perror("Error: strdup");
+				free(chunk_events);
 
-		inclReleaseContext(resource->context);
+				return EXIT_FAILURE;
+			}
+		}
 
-		free(resource);
+		/* Chunks on other command-queues can only be waited on once flushed. */
+		int error = inclFlushCommandQueuePool(resource->command_queue_pool) || inclEnqueueMarkerWithWaitList(buffer->command_queue, num_chunks, chunk_events, &event);
 
-		return INACCEL_FAILED;
-	}
+		for (chunk = 0; chunk < num_chunks; chunk++) {
+			inclReleaseEvent(chunk_events[chunk]);
+		}
 
-	size_t raw_name_size;
+		free(chunk_events);
+
+		if (error) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	set_buffer_event(buffer, event);
+
+	return EXIT_SUCCESS;
+}
+
+static int submit_copy_buffer_regions(cl_buffer buffer, cl_map_flags map_flags, unsigned int num_regions, const cl_buffer_copy_region *regions) {
+	cl_event event_wait_list[2];
+	cl_uint num_events_in_wait_list = get_buffer_wait_list(buffer, event_wait_list);
+
+	/* Regions of the same size, evenly spaced both in the buffer and in host memory, are copied as the rows of a single rectangle. */
+	unsigned char strided = num_regions > 1 && regions[0].size && regions[1].size == regions[0].size && regions[1].offset >= regions[0].offset + regions[0].size && (char *) regions[1].host >= (char *) regions[0].host + regions[0].size;
+
+	unsigned int i;
+	for (i = 2; strided && i < num_regions; i++) {
+		strided = regions[i].size == regions[0].size && regions[i].offset - regions[i - 1].offset == regions[1].offset - regions[0].offset && (char *) regions[i].host - (char *) regions[i - 1].host == (char *) regions[1].host - (char *) regions[0].host;
+	}
+
+	cl_event event;
+	if (strided) {
+		size_t buffer_origin[3], host_origin[3], region[3];
+		buffer_origin[0] = regions[0].offset;
+		buffer_origin[1] = buffer_origin[2] = 0;
+		host_origin[0] = host_origin[1] = host_origin[2] = 0;
+		region[0] = regions[0].size;
+		region[1] = num_regions;
+		region[2] = 1;
+
+		size_t buffer_row_pitch = regions[1].offset - regions[0].offset;
+		size_t host_row_pitch = (char *) regions[1].host - (char *) regions[0].host;
+
+		if (map_flags & CL_MAP_READ) {
+			if (inclEnqueueReadBufferRect(buffer->command_queue, buffer->mem, buffer_origin, host_origin, region, buffer_row_pitch, 0, host_row_pitch, 0, regions[0].host, num_events_in_wait_list, event_wait_list, &event)) {
+				return EXIT_FAILURE;
+			}
+		} else if (inclEnqueueWriteBufferRect(buffer->command_queue, buffer->mem, buffer_origin, host_origin, region, buffer_row_pitch, 0, host_row_pitch, 0, regions[0].host, num_events_in_wait_list, event_wait_list, &event)) {
+			return EXIT_FAILURE;
+		}
+	} else {
+		/* Any other regions are copied one by one, and tracked as one behind a marker. */
+		cl_event *region_events = (cl_event *) calloc(num_regions, sizeof(cl_event));
+		if (!region_events) {
+			perror("Error: calloc");
+
+			return EXIT_FAILURE;
+		}
+
+		for (i = 0; i < num_regions; i++) {
+			int error;
+			if (map_flags & CL_MAP_READ) {
+				error = inclEnqueueReadBuffer(buffer->command_queue, buffer->mem, regions[i].offset, regions[i].size, regions[i].host, num_events_in_wait_list, event_wait_list, &region_events[i]);
+			} else {
+				error = inclEnqueueWriteBuffer(buffer->command_queue, buffer->mem, regions[i].offset, regions[i].size, regions[i].host, num_events_in_wait_list, event_wait_list, &region_events[i]);
+			}
+
+			if (error) {
+				while (i--) {
+					inclReleaseEvent(region_events[i]);
+				}
+
+				free(region_events);
+
+				return EXIT_FAILURE;
+			}
+		}
+
+		int error = inclEnqueueMarkerWithWaitList(buffer->command_queue, num_regions, region_events, &event);
+
+		for (i = 0; i < num_regions; i++) {
+			inclReleaseEvent(region_events[i]);
+		}
+
+		free(region_events);
+
+		if (error) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	set_buffer_event(buffer, event);
+
+	return EXIT_SUCCESS;
+}
+
+static int submit_copy_buffer_to_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size) {
+	cl_event event_wait_list[4];
+	cl_uint num_events_in_wait_list = get_buffer_wait_list(src_buffer, event_wait_list);
+	num_events_in_wait_list += get_buffer_wait_list(dst_buffer, event_wait_list + num_events_in_wait_list);
+
+	cl_event event;
+	if (inclEnqueueCopyBuffer(dst_buffer->command_queue, src_buffer->mem, dst_buffer->mem, src_offset, dst_offset, size, num_events_in_wait_list, event_wait_list, &event)) {
+		return EXIT_FAILURE;
+	}
+
+	/* The copy can be awaited through either buffer, and keeps the source from being written before it is read. */
+	if (src_buffer != dst_buffer) {
+		inclRetainEvent(event);
+
+		set_buffer_event(src_buffer, event);
+	}
+	set_buffer_event(dst_buffer, event);
+
+	return EXIT_SUCCESS;
+}
+
+static void submit_copy_buffer_to_buffer_routine(void *arg) {
+	struct buffer_copy *buffer_copy = (struct buffer_copy *) arg;
+
+	if (submit_copy_buffer_to_buffer(buffer_copy->src_buffer, buffer_copy->dst_buffer, buffer_copy->src_offset, buffer_copy->dst_offset, buffer_copy->size)) {
+		buffer_copy->src_buffer->error = 1;
+		buffer_copy->dst_buffer->error = 1;
+	}
+}
+
+static int submit_copy_from_buffer(cl_buffer buffer) {
+	return submit_copy_buffer(buffer, CL_MAP_READ, 0, buffer->size);
+}
+
+static void submit_copy_from_buffer_routine(void *arg) {
+	cl_buffer buffer = *(cl_buffer *) arg;
+
+	if (submit_copy_from_buffer(buffer)) {
+		buffer->error = 1;
+	}
+}
+
+static int submit_copy_from_buffer_range(cl_buffer buffer, size_t offset, size_t size) {
+	return submit_copy_buffer(buffer, CL_MAP_READ, offset, size);
+}
+
+static void submit_copy_from_buffer_range_routine(void *arg) {
+	struct buffer_range *range = (struct buffer_range *) arg;
+
+	if (submit_copy_from_buffer_range(range->buffer, range->offset, range->size)) {
+		range->buffer->error = 1;
+	}
+}
+
+static int submit_copy_from_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions) {
+	return submit_copy_buffer_regions(buffer, CL_MAP_READ, num_regions, regions);
+}
+
+static void submit_copy_from_buffer_regions_routine(void *arg) {
+	struct buffer_regions *regions = (struct buffer_regions *) arg;
+
+	if (submit_copy_from_buffer_regions(regions->buffer, regions->num_regions, regions->region)) {
+		regions->buffer->error = 1;
+	}
+}
+
+static int submit_copy_from_buffers(unsigned int num_buffers, const cl_buffer *buffers) {
+	unsigned int i;
+	for (i = 0; i < num_buffers; i++) {
+		if (submit_copy_from_buffer(buffers[i])) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void submit_copy_from_buffers_routine(void *arg) {
+	struct buffer_list *buffer_list = (struct buffer_list *) arg;
+
+	if (submit_copy_from_buffers(buffer_list->num_buffers, buffer_list->buffer)) {
+		unsigned int i;
+		for (i = 0; i < buffer_list->num_buffers; i++) {
+			buffer_list->buffer[i]->error = 1;
+		}
+	}
+}
+
+static int submit_copy_to_buffer(cl_buffer buffer) {
+	/* The contents of output buffers are left to the compute units, so copying them to their memory only orders them after what came before. */
+	if (buffer->access == INACCEL_BUFFER_WRITE_ONLY) {
+		return submit_buffer_marker(buffer);
+	}
+
+	return submit_copy_buffer(buffer, CL_MAP_WRITE_INVALIDATE_REGION, 0, buffer->size);
+}
+
+static void submit_copy_to_buffer_routine(void *arg) {
+	cl_buffer buffer = *(cl_buffer *) arg;
+
+	if (submit_copy_to_buffer(buffer)) {
+		buffer->error = 1;
+	}
+}
+
+static int submit_copy_to_buffer_range(cl_buffer buffer, size_t offset, size_t size) {
+	return submit_copy_buffer(buffer, CL_MAP_WRITE_INVALIDATE_REGION, offset, size);
+}
+
+static void submit_copy_to_buffer_range_routine(void *arg) {
+	struct buffer_range *range = (struct buffer_range *) arg;
+
+	if (submit_copy_to_buffer_range(range->buffer, range->offset, range->size)) {
+		range->buffer->error = 1;
+	}
+}
+
+static int submit_copy_to_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions) {
+	return submit_copy_buffer_regions(buffer, CL_MAP_WRITE_INVALIDATE_REGION, num_regions, regions);
+}
+
+static void submit_copy_to_buffer_regions_routine(void *arg) {
+	struct buffer_regions *regions = (struct buffer_regions *) arg;
+
+	if (submit_copy_to_buffer_regions(regions->buffer, regions->num_regions, regions->region)) {
+		regions->buffer->error = 1;
+	}
+}
+
+static int submit_copy_to_buffers(unsigned int num_buffers, const cl_buffer *buffers) {
+	unsigned int i;
+	for (i = 0; i < num_buffers; i++) {
+		if (submit_copy_to_buffer(buffers[i])) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void submit_copy_to_buffers_routine(void *arg) {
+	struct buffer_list *buffer_list = (struct buffer_list *) arg;
+
+	if (submit_copy_to_buffers(buffer_list->num_buffers, buffer_list->buffer)) {
+		unsigned int i;
+		for (i = 0; i < buffer_list->num_buffers; i++) {
+			buffer_list->buffer[i]->error = 1;
+		}
+	}
+}
+
+static int submit_fill_buffer(cl_buffer buffer, const void *pattern, size_t pattern_size, size_t offset, size_t size) {
+	cl_event event_wait_list[2];
+	cl_uint num_events_in_wait_list = get_buffer_wait_list(buffer, event_wait_list);
+
+	cl_event event;
+	if (inclEnqueueFillBuffer(buffer->command_queue, buffer->mem, pattern, pattern_size, offset, size, num_events_in_wait_list, event_wait_list, &event)) {
+		return EXIT_FAILURE;
+	}
+
+	set_buffer_event(buffer, event);
+
+	return EXIT_SUCCESS;
+}
+
+static void submit_fill_buffer_routine(void *arg) {
+	struct buffer_fill *buffer_fill = (struct buffer_fill *) arg;
+
+	if (submit_fill_buffer(buffer_fill->buffer, buffer_fill->pattern, buffer_fill->pattern_size, buffer_fill->offset, buffer_fill->size)) {
+		buffer_fill->buffer->error = 1;
+	}
+}
+
+static int submit_repeat_compute_unit_run(cl_compute_unit compute_unit, unsigned int num_runs, unsigned int index, size_t size, const void *values) {
+	cl_uint num_events_in_wait_list = get_compute_unit_wait_list(compute_unit);
+
+	cl_event event = NULL;
+
+	unsigned int run;
+	for (run = 0; run < num_runs; run++) {
+		if (size) {
+			if (apply_compute_unit_arg(compute_unit, index, size, (const char *) values + run * size)) {
+				if (event) {
+					inclReleaseEvent(event);
+				}
+
+				return EXIT_FAILURE;
+			}
+
+			compute_unit->arg_node[index] = NULL;
+		}
+
+		/* The runs in between only need an event to be chained on out-of-order queues. */
+		cl_event next = NULL;
+		if (inclEnqueueTask(compute_unit->command_queue, compute_unit->kernel, num_events_in_wait_list, compute_unit->event_wait_list, (run == num_runs - 1 || compute_unit->out_of_order) ? &next : NULL)) {
+			if (event) {
+				inclReleaseEvent(event);
+			}
+
+			return EXIT_FAILURE;
+		}
+
+		if (event) {
+			inclReleaseEvent(event);
+		}
+		event = next;
+
+		num_events_in_wait_list = 0;
+		if (event) {
+			compute_unit->event_wait_list[num_events_in_wait_list++] = event;
+		}
+	}
+
+	return set_compute_unit_event(compute_unit, event);
+}
+
+static void submit_repeat_compute_unit_run_routine(void *arg) {
+	struct compute_unit_runs *compute_unit_runs = (struct compute_unit_runs *) arg;
+
+	if (submit_repeat_compute_unit_run(compute_unit_runs->compute_unit, compute_unit_runs->num_runs, compute_unit_runs->index, compute_unit_runs->size, compute_unit_runs->values)) {
+		compute_unit_runs->compute_unit->error = 1;
+	}
+}
+
+static int submit_run_compute_unit(cl_compute_unit compute_unit) {
+	cl_uint num_events_in_wait_list = get_compute_unit_wait_list(compute_unit);
+
+	cl_event event;
+	if (inclEnqueueTask(compute_unit->command_queue, compute_unit->kernel, num_events_in_wait_list, compute_unit->event_wait_list, &event)) {
+		return EXIT_FAILURE;
+	}
+
+	return set_compute_unit_event(compute_unit, event);
+}
+
+static void submit_run_compute_unit_routine(void *arg) {
+	cl_compute_unit compute_unit = *(cl_compute_unit *) arg;
+
+	if (submit_run_compute_unit(compute_unit)) {
+		compute_unit->error = 1;
+	}
+}
+
+static int submit_graph(cl_graph graph) {
+	unsigned int i;
+	for (i = 0; i < graph->num_nodes; i++) {
+		struct graph_node *node = graph->node[i];
+
+		switch (node->type) {
+			case GRAPH_NODE_COMPUTE_UNIT_ARG:
+				/* Arguments still set by this node are only re-set if their value changed. */
+				if (node->compute_unit->arg_node[node->index] == node && (!node->size || !memcmp(node->last, node->value, node->size))) {
+					if (!node->size) {
+						node->compute_unit->buffer[node->index] = node->buffer;
+					}
+
+					break;
+				}
+
+				if (submit_compute_unit_arg(node->compute_unit, node->index, node->size, node->size ? node->value : node->buffer)) {
+					return EXIT_FAILURE;
+				}
+
+				if (node->size) {
+					memcpy(node->last, node->value, node->size);
+				}
+				node->compute_unit->arg_node[node->index] = node;
+
+				break;
+			case GRAPH_NODE_COMPUTE_UNIT_RUN:
+				if (submit_run_compute_unit(node->compute_unit)) {
+					return EXIT_FAILURE;
+				}
+
+				break;
+			case GRAPH_NODE_COPY_FROM_BUFFER:
+				if (submit_copy_from_buffer(node->buffer)) {
+					return EXIT_FAILURE;
+				}
+
+				break;
+			case GRAPH_NODE_COPY_TO_BUFFER:
+				if (submit_copy_to_buffer(node->buffer)) {
+					return EXIT_FAILURE;
+				}
+
+				break;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void submit_graph_routine(void *arg) {
+	cl_graph graph = *(cl_graph *) arg;
+
+	if (submit_graph(graph)) {
+		unsigned int i;
+		for (i = 0; i < graph->num_nodes; i++) {
+			if (graph->node[i]->buffer) {
+				graph->node[i]->buffer->error = 1;
+			}
+			if (graph->node[i]->compute_unit) {
+				graph->node[i]->compute_unit->error = 1;
+			}
+		}
+	}
+}
+
+static int submit_pipeline_chunk(cl_pipeline pipeline, unsigned int slot, const void *input, void *output, size_t size) {
+	cl_buffer input_buffer = pipeline->input[slot];
+	cl_buffer output_buffer = pipeline->output[slot];
+
+	cl_event event_wait_list[2];
+	cl_uint num_events_in_wait_list = get_buffer_wait_list(input_buffer, event_wait_list);
+
+	cl_event event;
+	if (inclEnqueueWriteBuffer(input_buffer->command_queue, input_buffer->mem, 0, size, input, num_events_in_wait_list, event_wait_list, &event)) {
+		return EXIT_FAILURE;
+	}
+
+	set_buffer_event(input_buffer, event);
+
+	if (submit_compute_unit_arg(pipeline->compute_unit, pipeline->input_index, 0, input_buffer)) {
+		return EXIT_FAILURE;
+	}
+	if (submit_compute_unit_arg(pipeline->compute_unit, pipeline->output_index, 0, output_buffer)) {
+		return EXIT_FAILURE;
+	}
+	if (submit_run_compute_unit(pipeline->compute_unit)) {
+		return EXIT_FAILURE;
+	}
+
+	num_events_in_wait_list = get_buffer_wait_list(output_buffer, event_wait_list);
+
+	if (inclEnqueueReadBuffer(output_buffer->command_queue, output_buffer->mem, 0, size, output, num_events_in_wait_list, event_wait_list, &event)) {
+		return EXIT_FAILURE;
+	}
+
+	set_buffer_event(output_buffer, event);
+
+	return EXIT_SUCCESS;
+}
+
+static void submit_pipeline_chunk_routine(void *arg) {
+	struct pipeline_chunk *pipeline_chunk = (struct pipeline_chunk *) arg;
+
+	if (submit_pipeline_chunk(pipeline_chunk->pipeline, pipeline_chunk->slot, pipeline_chunk->input, pipeline_chunk->output, pipeline_chunk->size)) {
+		pipeline_chunk->pipeline->error = 1;
+	}
+}
+
+static int timed_wait_for_submission(cl_resource resource, unsigned long submission, unsigned long *timeout_usec) {
+	if (resource->submission_queue) {
+		return inclTimedWaitForSubmission(resource->submission_queue, submission, timeout_usec);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static void wait_for_submission(cl_resource resource, unsigned long submission) {
+	if (resource->submission_queue) {
+		inclWaitForSubmission(resource->submission_queue, submission);
+	}
+}
+
+static void wait_for_submissions(cl_resource resource) {
+	if (resource->submission_queue) {
+		inclWaitForSubmissions(resource->submission_queue);
+	}
+}
+
+int add_graph_compute_unit_arg(cl_graph graph, cl_compute_unit compute_unit, unsigned int index, size_t size, const void *value) {
+	wait_for_submissions(graph->resource);
+
+	if (index >= compute_unit->num_args) {
+		return EXIT_FAILURE;
+	}
+
+	void *last = NULL;
+	if (size && !(last = malloc(size))) {
+		perror("Error: malloc");
+
+		return EXIT_FAILURE;
+	}
+
+	struct graph_node *node = create_graph_node(graph, GRAPH_NODE_COMPUTE_UNIT_ARG);
+	if (!node) {
+		free(last);
+
+		return EXIT_FAILURE;
+	}
+
+	node->compute_unit = compute_unit;
+	node->index = index;
+	node->size = size;
+	if (size) {
+		node->value = value;
+		node->last = last;
+	} else {
+		node->buffer = (cl_buffer) value;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+int add_graph_compute_unit_run(cl_graph graph, cl_compute_unit compute_unit) {
+	wait_for_submissions(graph->resource);
+
+	struct graph_node *node = create_graph_node(graph, GRAPH_NODE_COMPUTE_UNIT_RUN);
+	if (!node) {
+		return EXIT_FAILURE;
+	}
+
+	node->compute_unit = compute_unit;
+
+	return EXIT_SUCCESS;
+}
+
+int add_graph_copy_from_buffer(cl_graph graph, cl_buffer buffer) {
+	if (buffer->access == INACCEL_BUFFER_DEVICE_ONLY) {
+		return EXIT_FAILURE;
+	}
+
+	wait_for_submissions(graph->resource);
+
+	struct graph_node *node = create_graph_node(graph, GRAPH_NODE_COPY_FROM_BUFFER);
+	if (!node) {
+		return EXIT_FAILURE;
+	}
+
+	node->buffer = buffer;
+
+	return EXIT_SUCCESS;
+}
+
+int add_graph_copy_to_buffer(cl_graph graph, cl_buffer buffer) {
+	if (buffer->access == INACCEL_BUFFER_DEVICE_ONLY) {
+		return EXIT_FAILURE;
+	}
+
+	wait_for_submissions(graph->resource);
+
+	struct graph_node *node = create_graph_node(graph, GRAPH_NODE_COPY_TO_BUFFER);
+	if (!node) {
+		return EXIT_FAILURE;
+	}
+
+	node->buffer = buffer;
+
+	return EXIT_SUCCESS;
+}
+
+int await_buffer_copy(cl_buffer buffer) {
+	wait_for_submissions(buffer->memory->resource);
+
+	if (buffer->error) {
+		buffer->error = 0;
+
+		return EXIT_FAILURE;
+	}
+
+	if (!buffer->event) {
+		return EXIT_SUCCESS;
+	}
+
+	int error = inclWaitForEvent(buffer->event, buffer->memory->resource->wait_spin_usec);
+
+	inclReleaseEvent(buffer->event);
+	buffer->event = NULL;
+
+	return error;
+}
+
+int await_compute_unit_run(cl_compute_unit compute_unit) {
+	wait_for_submissions(compute_unit->resource);
+
+	if (compute_unit->error) {
+		compute_unit->error = 0;
+
+		return EXIT_FAILURE;
+	}
+
+	if (!compute_unit->event) {
+		return EXIT_SUCCESS;
+	}
+
+	int error = inclWaitForEvent(compute_unit->event, compute_unit->resource->wait_spin_usec);
+
+	inclReleaseEvent(compute_unit->event);
+	compute_unit->event = NULL;
+
+	return error;
+}
+
+int await_graph_replay(cl_graph graph) {
+	int error = EXIT_SUCCESS;
+
+	unsigned int i;
+	for (i = 0; i < graph->num_nodes; i++) {
+		switch (graph->node[i]->type) {
+			case GRAPH_NODE_COMPUTE_UNIT_RUN:
+				if (await_compute_unit_run(graph->node[i]->compute_unit)) {
+					error = EXIT_FAILURE;
+				}
+				break;
+			case GRAPH_NODE_COPY_FROM_BUFFER:
+			case GRAPH_NODE_COPY_TO_BUFFER:
+				if (await_buffer_copy(graph->node[i]->buffer)) {
+					error = EXIT_FAILURE;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	return error;
+}
+
+int await_pipeline(cl_pipeline pipeline) {
+	wait_for_submissions(pipeline->compute_unit->resource);
+
+	int error = EXIT_SUCCESS;
+
+	if (pipeline->error) {
+		pipeline->error = 0;
+
+		error = EXIT_FAILURE;
+	}
+
+	unsigned int slot;
+	for (slot = 0; slot < pipeline->depth; slot++) {
+		if (await_buffer_copy(pipeline->input[slot])) {
+			error = EXIT_FAILURE;
+		}
+		if (await_buffer_copy(pipeline->output[slot])) {
+			error = EXIT_FAILURE;
+		}
+	}
+
+	pipeline->num_pending = 0;
+
+	return error;
+}
+
+int copy_buffer_to_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size) {
+	if (src_buffer->memory->resource != dst_buffer->memory->resource) {
+		return EXIT_FAILURE;
+	}
+
+	if (src_offset > src_buffer->size || size > src_buffer->size - src_offset || dst_offset > dst_buffer->size || size > dst_buffer->size - dst_offset) {
+		return EXIT_FAILURE;
+	}
+
+	if (dst_buffer->memory->resource->submission_queue) {
+		struct buffer_copy *arg = (struct buffer_copy *) inclCreateSubmission(&submit_copy_buffer_to_buffer_routine, sizeof(struct buffer_copy));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		arg->src_buffer = src_buffer;
+		arg->dst_buffer = dst_buffer;
+		arg->src_offset = src_offset;
+		arg->dst_offset = dst_offset;
+		arg->size = size;
+
+		src_buffer->submission = dst_buffer->submission = inclSubmit(dst_buffer->memory->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_buffer_to_buffer(src_buffer, dst_buffer, src_offset, dst_offset, size)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlush(dst_buffer->command_queue);
+}
+
+int copy_buffer_to_peer_buffer(cl_buffer src_buffer, cl_buffer dst_buffer, size_t src_offset, size_t dst_offset, size_t size) {
+	if (src_buffer->memory->resource == dst_buffer->memory->resource) {
+		return copy_buffer_to_buffer(src_buffer, dst_buffer, src_offset, dst_offset, size);
+	}
+
+	if (src_offset > src_buffer->size || size > src_buffer->size - src_offset || dst_offset > dst_buffer->size || size > dst_buffer->size - dst_offset) {
+		return EXIT_FAILURE;
+	}
+
+	if (!size) {
+		return EXIT_SUCCESS;
+	}
+
+	/* Neither resource can wait on the events of the other, so the chunks are handed over by the calling thread. */
+	wait_for_submissions(src_buffer->memory->resource);
+	wait_for_submissions(dst_buffer->memory->resource);
+
+	size_t chunk_size = src_buffer->memory->resource->copy_chunk_size ? src_buffer->memory->resource->copy_chunk_size : DEFAULT_PEER_CHUNK_SIZE;
+	if (chunk_size > size) {
+		chunk_size = size;
+	}
+
+	/* Chunks are staged in host memory, reading one while the previous is written. */
+	char *staging = (char *) malloc(2 * chunk_size);
+	if (!staging) {
+		perror("Error: malloc");
+
+		return EXIT_FAILURE;
+	}
+
+	cl_event src_event_wait_list[2];
+	cl_uint num_src_events = get_buffer_wait_list(src_buffer, src_event_wait_list);
+
+	cl_event dst_event_wait_list[2];
+	cl_uint num_dst_events = get_buffer_wait_list(dst_buffer, dst_event_wait_list);
+
+	cl_event read_events[2] = {NULL, NULL};
+	cl_event write_events[2] = {NULL, NULL};
+
+	unsigned int num_chunks = (size + chunk_size - 1) / chunk_size;
+
+	int error = 0;
+
+	unsigned int chunk;
+	for (chunk = 0; !error && chunk <= num_chunks; chunk++) {
+		unsigned int slot;
+		size_t offset, length;
+
+		if (chunk < num_chunks) {
+			slot = chunk % 2;
+			offset = chunk * chunk_size;
+			length = size - offset < chunk_size ? size - offset : chunk_size;
+
+			/* The half of the staging memory has to be written out before it is read into again. */
+			if (write_events[slot]) {
+				error = inclWaitForEvents(1, &write_events[slot]);
+
+				inclReleaseEvent(write_events[slot]);
+				write_events[slot] = NULL;
+
+				if (error) {
+					break;
+				}
+			}
+
+			error = inclEnqueueReadBuffer(src_buffer->command_queue, src_buffer->mem, src_offset + offset, length, staging + slot * chunk_size, num_src_events, src_event_wait_list, &read_events[slot]) || inclFlush(src_buffer->command_queue);
+		}
+
+		if (!error && chunk) {
+			slot = (chunk - 1) % 2;
+			offset = (chunk - 1) * chunk_size;
+			length = size - offset < chunk_size ? size - offset : chunk_size;
+
+			error = inclWaitForEvents(1, &read_events[slot]);
+
+			inclReleaseEvent(read_events[slot]);
+			read_events[slot] = NULL;
+
+			if (!error) {
+				error = inclEnqueueWriteBuffer(dst_buffer->command_queue, dst_buffer->mem, dst_offset + offset, length, staging + slot * chunk_size, num_dst_events, dst_event_wait_list, &write_events[slot]) || inclFlush(dst_buffer->command_queue);
+			}
+		}
+	}
+
+	/* The staging memory can only go once nothing reads or writes it. */
+	unsigned int slot;
+	for (slot = 0; slot < 2; slot++) {
+		if (read_events[slot]) {
+			inclWaitForEvents(1, &read_events[slot]);
+
+			inclReleaseEvent(read_events[slot]);
+		}
+		if (write_events[slot]) {
+			if (inclWaitForEvents(1, &write_events[slot])) {
+				error = 1;
+			}
+
+			inclReleaseEvent(write_events[slot]);
+		}
+	}
+
+	free(staging);
+
+	return error ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int copy_from_buffer(cl_buffer buffer) {
+	if (buffer->access == INACCEL_BUFFER_DEVICE_ONLY) {
+		return EXIT_FAILURE;
+	}
+
+	if (buffer->memory->resource->submission_queue) {
+		cl_buffer *arg = (cl_buffer *) inclCreateSubmission(&submit_copy_from_buffer_routine, sizeof(cl_buffer));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		*arg = buffer;
+
+		buffer->submission = inclSubmit(buffer->memory->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_from_buffer(buffer)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlush(buffer->command_queue);
+}
+
+int copy_from_buffer_range(cl_buffer buffer, size_t offset, size_t size) {
+	if (buffer->access == INACCEL_BUFFER_DEVICE_ONLY || offset > buffer->size || size > buffer->size - offset) {
+		return EXIT_FAILURE;
+	}
+
+	if (buffer->memory->resource->submission_queue) {
+		struct buffer_range *arg = (struct buffer_range *) inclCreateSubmission(&submit_copy_from_buffer_range_routine, sizeof(struct buffer_range));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		arg->buffer = buffer;
+		arg->offset = offset;
+		arg->size = size;
+
+		buffer->submission = inclSubmit(buffer->memory->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_from_buffer_range(buffer, offset, size)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlush(buffer->command_queue);
+}
+
+int copy_from_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions) {
+	if (!num_regions) {
+		return EXIT_SUCCESS;
+	}
+
+	unsigned int i;
+	for (i = 0; i < num_regions; i++) {
+		if (regions[i].offset > buffer->size || regions[i].size > buffer->size - regions[i].offset) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (buffer->memory->resource->submission_queue) {
+		struct buffer_regions *arg = (struct buffer_regions *) inclCreateSubmission(&submit_copy_from_buffer_regions_routine, sizeof(struct buffer_regions) + num_regions * sizeof(cl_buffer_copy_region));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		arg->buffer = buffer;
+		arg->num_regions = num_regions;
+		memcpy(arg->region, regions, num_regions * sizeof(cl_buffer_copy_region));
+
+		buffer->submission = inclSubmit(buffer->memory->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_from_buffer_regions(buffer, num_regions, regions)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlush(buffer->command_queue);
+}
+
+int copy_from_buffers(unsigned int num_buffers, const cl_buffer *buffers) {
+	if (!num_buffers) {
+		return EXIT_SUCCESS;
+	}
+
+	unsigned int i;
+	for (i = 0; i < num_buffers; i++) {
+		if (buffers[i]->access == INACCEL_BUFFER_DEVICE_ONLY) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (buffers[0]->memory->resource->submission_queue) {
+		struct buffer_list *arg = (struct buffer_list *) inclCreateSubmission(&submit_copy_from_buffers_routine, sizeof(struct buffer_list) + num_buffers * sizeof(cl_buffer));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		arg->num_buffers = num_buffers;
+		memcpy(arg->buffer, buffers, num_buffers * sizeof(cl_buffer));
+
+		unsigned long submission = inclSubmit(buffers[0]->memory->resource->submission_queue, arg);
+		for (i = 0; i < num_buffers; i++) {
+			buffers[i]->submission = submission;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_from_buffers(num_buffers, buffers)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlushCommandQueuePool(buffers[0]->memory->resource->command_queue_pool);
+}
+
+int copy_to_buffer(cl_buffer buffer) {
+	if (buffer->access == INACCEL_BUFFER_DEVICE_ONLY) {
+		return EXIT_FAILURE;
+	}
+
+	if (buffer->memory->resource->submission_queue) {
+		cl_buffer *arg = (cl_buffer *) inclCreateSubmission(&submit_copy_to_buffer_routine, sizeof(cl_buffer));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		*arg = buffer;
+
+		buffer->submission = inclSubmit(buffer->memory->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_to_buffer(buffer)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlush(buffer->command_queue);
+}
+
+int copy_to_buffer_range(cl_buffer buffer, size_t offset, size_t size) {
+	if (buffer->access == INACCEL_BUFFER_DEVICE_ONLY || offset > buffer->size || size > buffer->size - offset) {
+		return EXIT_FAILURE;
+	}
+
+	if (buffer->memory->resource->submission_queue) {
+		struct buffer_range *arg = (struct buffer_range *) inclCreateSubmission(&submit_copy_to_buffer_range_routine, sizeof(struct buffer_range));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		arg->buffer = buffer;
+		arg->offset = offset;
+		arg->size = size;
+
+		buffer->submission = inclSubmit(buffer->memory->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_to_buffer_range(buffer, offset, size)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlush(buffer->command_queue);
+}
+
+int copy_to_buffer_regions(cl_buffer buffer, unsigned int num_regions, const cl_buffer_copy_region *regions) {
+	if (!num_regions) {
+		return EXIT_SUCCESS;
+	}
+
+	unsigned int i;
+	for (i = 0; i < num_regions; i++) {
+		if (regions[i].offset > buffer->size || regions[i].size > buffer->size - regions[i].offset) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (buffer->memory->resource->submission_queue) {
+		struct buffer_regions *arg = (struct buffer_regions *) inclCreateSubmission(&submit_copy_to_buffer_regions_routine, sizeof(struct buffer_regions) + num_regions * sizeof(cl_buffer_copy_region));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		arg->buffer = buffer;
+		arg->num_regions = num_regions;
+		memcpy(arg->region, regions, num_regions * sizeof(cl_buffer_copy_region));
+
+		buffer->submission = inclSubmit(buffer->memory->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_to_buffer_regions(buffer, num_regions, regions)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlush(buffer->command_queue);
+}
+
+int copy_to_buffers(unsigned int num_buffers, const cl_buffer *buffers) {
+	if (!num_buffers) {
+		return EXIT_SUCCESS;
+	}
+
+	unsigned int i;
+	for (i = 0; i < num_buffers; i++) {
+		if (buffers[i]->access == INACCEL_BUFFER_DEVICE_ONLY) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (buffers[0]->memory->resource->submission_queue) {
+		struct buffer_list *arg = (struct buffer_list *) inclCreateSubmission(&submit_copy_to_buffers_routine, sizeof(struct buffer_list) + num_buffers * sizeof(cl_buffer));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		arg->num_buffers = num_buffers;
+		memcpy(arg->buffer, buffers, num_buffers * sizeof(cl_buffer));
+
+		unsigned long submission = inclSubmit(buffers[0]->memory->resource->submission_queue, arg);
+		for (i = 0; i < num_buffers; i++) {
+			buffers[i]->submission = submission;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_copy_to_buffers(num_buffers, buffers)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlushCommandQueuePool(buffers[0]->memory->resource->command_queue_pool);
+}
+
+cl_buffer create_buffer(cl_memory memory, size_t size, void *host) {
+	return create_buffer_with_access(memory, size, host, INACCEL_BUFFER_READ_WRITE);
+}
+
+cl_buffer create_buffer_with_access(cl_memory memory, size_t size, void *host, int access) {
+	if (access < INACCEL_BUFFER_READ_WRITE || access > INACCEL_BUFFER_DEVICE_ONLY) {
+		return NULL;
+	}
+
+	cl_buffer buffer = (cl_buffer) calloc(1, sizeof(struct _cl_buffer));
+	if (!buffer) {
+		perror("Error: calloc");
+
+		return INACCEL_FAILED;
+	}
+
+	buffer->memory = memory;
+	buffer->size = size;
+	/* Device-only buffers are never copied to or from host memory. */
+	buffer->host = access == INACCEL_BUFFER_DEVICE_ONLY ? NULL : host;
+	buffer->access = access;
+	buffer->generation = memory->resource->generation;
+
+	/* The arena and cache are bypassed while they still belong to a replaced context. */
+	unsigned char current = refresh_memory(memory) ? 0 : 1;
+
+	/* Buffers of suitably aligned host memory are backed by it, and fall back to a buffer of their own otherwise. They are never cached, since the same address may be backed by other pages by the time it comes back. */
+	if (buffer->host && !((uintptr_t) buffer->host % AOCL_ALIGNMENT)) {
+		buffer->mem = inclCreateBuffer(memory->resource->context, get_buffer_mem_flags(buffer) | CL_MEM_USE_HOST_PTR, buffer->size, buffer->host);
+
+		buffer->zero_copy = buffer->mem ? 1 : 0;
+	}
+
+	/* Regions of the arena are handed out without calling into the driver for an allocation. */
+	if (!buffer->mem && current && memory->buddy_allocator && !inclAllocateBuddyBlock(memory->buddy_allocator, buffer->size, &buffer->offset)) {
+		cl_buffer_region region = {
+			buffer->offset,
+			buffer->size
+		};
+		if ((buffer->mem = inclCreateSubBuffer(memory->arena->mem, CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &region))) {
+			buffer->sub_buffer = 1;
+
+			memory->num_regions++;
+		} else {
+			inclFreeBuddyBlock(memory->buddy_allocator, buffer->offset);
+		}
+	}
+
+	buffer->mem_size = buffer->size;
+
+	if (!buffer->mem && current && memory->mem_cache) {
+		/* Cached buffers come in power of two sizes, so that any buffer of the same size class can reuse them. */
+		buffer->mem_size = 4096;
+		while (buffer->mem_size < buffer->size) {
+			buffer->mem_size *= 2;
+		}
+
+		buffer->mem = inclReuseMemObject(memory->mem_cache, buffer->mem_size, NULL);
+	}
+
+	if (!buffer->mem && !(buffer->mem = inclCreateBuffer(memory->resource->context, get_buffer_mem_flags(buffer), buffer->mem_size, NULL))) {
+		free(buffer);
+
+		return NULL;
+	}
+
+	buffer->command_queue = inclLeaseCommandQueue(memory->resource->command_queue_pool);
+
+	return buffer;
+}
+
+cl_compute_unit create_compute_unit(cl_resource resource, const char *name) {
+	cl_compute_unit compute_unit = (cl_compute_unit) calloc(1, sizeof(struct _cl_compute_unit));
+	if (!compute_unit) {
+		perror("Error: calloc");
+
+		return INACCEL_FAILED;
+	}
+
+	compute_unit->resource = resource;
+	if (!(compute_unit->name = strdup(name))) {
+		perror("Error: strdup");
+
+		free(compute_unit);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(compute_unit->kernel = inclCreateKernel(resource->program, compute_unit->name))) {
+		free(compute_unit->name);
+		free(compute_unit);
+
+		return NULL;
+	}
+
+	compute_unit->command_queue = inclLeaseCommandQueue(resource->command_queue_pool);
+
+	cl_command_queue_properties properties;
+	if (inclGetCommandQueueInfo(compute_unit->command_queue, CL_QUEUE_PROPERTIES, sizeof(cl_command_queue_properties), &properties, NULL)) {
+		properties = CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+	}
+	compute_unit->out_of_order = (properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) ? 1 : 0;
+
+	if (inclGetKernelInfo(compute_unit->kernel, CL_KERNEL_NUM_ARGS, sizeof(unsigned int), &compute_unit->num_args, NULL)) {
+		inclReleaseCommandQueue(compute_unit->command_queue);
+
+		inclReleaseKernel(compute_unit->kernel);
+
+		free(compute_unit->name);
+		free(compute_unit);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(compute_unit->buffer = (cl_buffer *) calloc(compute_unit->num_args, sizeof(cl_buffer)))) {
+		perror("Error: calloc");
+
+		inclReleaseCommandQueue(compute_unit->command_queue);
+
+		inclReleaseKernel(compute_unit->kernel);
+
+		free(compute_unit->name);
+		free(compute_unit);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(compute_unit->event_wait_list = (cl_event *) calloc(1 + 2 * compute_unit->num_args, sizeof(cl_event)))) {
+		perror("Error: calloc");
+
+		inclReleaseCommandQueue(compute_unit->command_queue);
+
+		inclReleaseKernel(compute_unit->kernel);
+
+		free(compute_unit->buffer);
+		free(compute_unit->name);
+		free(compute_unit);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(compute_unit->arg_node = (struct graph_node **) calloc(compute_unit->num_args, sizeof(struct graph_node *)))) {
+		perror("Error: calloc");
+
+		inclReleaseCommandQueue(compute_unit->command_queue);
+
+		inclReleaseKernel(compute_unit->kernel);
+
+		free(compute_unit->buffer);
+		free(compute_unit->event_wait_list);
+		free(compute_unit->name);
+		free(compute_unit);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(compute_unit->kernel_arg = (struct kernel_arg *) calloc(compute_unit->num_args, sizeof(struct kernel_arg)))) {
+		perror("Error: calloc");
+
+		inclReleaseCommandQueue(compute_unit->command_queue);
+
+		inclReleaseKernel(compute_unit->kernel);
+
+		free(compute_unit->arg_node);
+		free(compute_unit->buffer);
+		free(compute_unit->event_wait_list);
+		free(compute_unit->name);
+		free(compute_unit);
+
+		return INACCEL_FAILED;
+	}
+
+	compute_unit->depth = 1;
+
+	const char *depth = getenv("INACCEL_COMPUTE_UNIT_DEPTH");
+	if (depth) {
+		unsigned long value = strtoul(depth, NULL, 10);
+		if (value > MAX_COMPUTE_UNIT_DEPTH || set_compute_unit_depth(compute_unit, value)) {
+			fprintf(stderr, "Error: INACCEL_COMPUTE_UNIT_DEPTH %s\n", depth);
+		}
+	}
+
+	return compute_unit;
+}
+
+cl_graph create_graph(cl_resource resource) {
+	cl_graph graph = (cl_graph) calloc(1, sizeof(struct _cl_graph));
+	if (!graph) {
+		perror("Error: calloc");
+
+		return INACCEL_FAILED;
+	}
+
+	graph->resource = resource;
+
+	return graph;
+}
+
+cl_memory create_memory(cl_resource resource, unsigned int index) {
+	if (!index) {
+		cl_memory memory = (cl_memory) calloc(1, sizeof(struct _cl_memory));
+		if (!memory) {
+			perror("Error: calloc");
+
+			return INACCEL_FAILED;
+		}
+
+		memory->resource = resource;
+		memory->index = index;
+
+		if (inclGetDeviceInfo(resource->device_id, CL_DEVICE_GLOBAL_MEM_SIZE, sizeof(size_t), &memory->size, NULL)) {
+			free(memory);
+
+			return INACCEL_FAILED;
+		}
+
+		if (!(memory->type = strdup("DDR"))) {
+			perror("Error: strdup");
+
+			free(memory);
+
+			return INACCEL_FAILED;
+		}
+
+		memory->generation = resource->generation;
+
+		const char *arena_size = getenv("INACCEL_MEMORY_ARENA_SIZE");
+		if (arena_size && (memory->arena_size = strtoul(arena_size, NULL, 10))) {
+			reserve_memory_arena(memory, memory->arena_size);
+		}
+
+		const char *buffer_cache_size = getenv("INACCEL_BUFFER_CACHE_SIZE");
+		if (buffer_cache_size && (memory->mem_cache_budget = strtoul(buffer_cache_size, NULL, 10))) {
+			memory->mem_cache = inclCreateMemCache(memory->mem_cache_budget);
+		}
+
+		return memory;
+	}
+	return NULL;
+}
+
+cl_pipeline create_pipeline(cl_compute_unit compute_unit, unsigned int input_index, cl_memory input_memory, unsigned int output_index, cl_memory output_memory, size_t chunk_size, unsigned int depth) {
+	if (input_index >= compute_unit->num_args || output_index >= compute_unit->num_args || input_index == output_index || !chunk_size || !depth) {
+		return INACCEL_FAILED;
+	}
+
+	cl_pipeline pipeline = (cl_pipeline) calloc(1, sizeof(struct _cl_pipeline));
+	if (!pipeline) {
+		perror("Error: calloc");
+
+		return INACCEL_FAILED;
+	}
+
+	pipeline->compute_unit = compute_unit;
+	pipeline->input_index = input_index;
+	pipeline->output_index = output_index;
+	pipeline->chunk_size = chunk_size;
+	pipeline->depth = depth;
+
+	if (!(pipeline->input = (cl_buffer *) calloc(depth, sizeof(cl_buffer)))) {
+		perror("Error: calloc");
+
+		free(pipeline);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(pipeline->output = (cl_buffer *) calloc(depth, sizeof(cl_buffer)))) {
+		perror("Error: calloc");
+
+		free(pipeline->input);
+		free(pipeline);
+
+		return INACCEL_FAILED;
+	}
+
+	unsigned int slot;
+	for (slot = 0; slot < depth; slot++) {
+		if (!(pipeline->input[slot] = create_device_buffer(input_memory, chunk_size)) || !(pipeline->output[slot] = create_device_buffer(output_memory, chunk_size))) {
+			for (slot = 0; slot < depth; slot++) {
+				if (pipeline->input[slot]) {
+					release_buffer(pipeline->input[slot]);
+				}
+				if (pipeline->output[slot]) {
+					release_buffer(pipeline->output[slot]);
+				}
+			}
+
+			free(pipeline->input);
+			free(pipeline->output);
+			free(pipeline);
+
+			return INACCEL_FAILED;
+		}
+	}
+
+	return pipeline;
+}
+
+cl_resource create_resource(unsigned int index) {
+	cl_resource resource = (cl_resource) calloc(1, sizeof(struct _cl_resource));
+	if (!resource) {
+		perror("Error: calloc");
+
+		return INACCEL_FAILED;
+	}
+
+	resource->index = index;
+
+	if (!(resource->platform_id = inclGetPlatformID("Intel"))) {
+		free(resource);
+
+		return NULL;
+	}
+
+	if (!(resource->device_id = inclGetDeviceID(resource->platform_id, resource->index))) {
+		free(resource);
+
+		return NULL;
+	}
+
+	if (!(resource->context = inclCreateContext(resource->device_id))) {
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(resource->vendor = strdup("intel"))) {
+		perror("Error: strdup");
+
+		inclReleaseContext(resource->context);
+
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	size_t raw_name_size;
 	if (inclGetDeviceInfo(resource->device_id, CL_DEVICE_NAME, 0, NULL, &raw_name_size)) {
 		inclReleaseContext(resource->context);
 
-		free(resource);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	char *raw_name = (char *) calloc(raw_name_size, sizeof(char));
+	if (!raw_name) {
+		perror("Error: calloc");
+
+		inclReleaseContext(resource->context);
+
+		free(resource->vendor);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	if (inclGetDeviceInfo(resource->device_id, CL_DEVICE_NAME, raw_name_size, raw_name, NULL)) {
+		free(raw_name);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->vendor);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(resource->name = (char *) calloc(raw_name_size, sizeof(char)))) {
+		perror("Error: calloc");
+
+		free(raw_name);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->vendor);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	const char *regex = "^([^ : ]+) : .*_(.+)0000(.).$";
+
+	regex_t compile;
+	regmatch_t group[4];
+
+	if (regcomp(&compile, regex, REG_EXTENDED)) {
+		perror("Error: regcomp");
+
+		free(raw_name);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->vendor);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	if (regexec(&compile, raw_name, 4, group, 0)) {
+		perror("Error: regexec");
+
+		regfree(&compile);
+
+		free(raw_name);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->vendor);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	strncpy(resource->name, raw_name + group[1].rm_so, group[1].rm_eo - group[1].rm_so);
+
+	char *tmp;
+
+	tmp = strndup(raw_name + group[2].rm_so, group[2].rm_eo - group[2].rm_so);
+	if (!tmp) {
+		perror("Error: strndup");
+
+		regfree(&compile);
+
+		free(raw_name);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->vendor);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+	long major = strtol(tmp, NULL, 16);
+	free(tmp);
+
+	tmp = strndup(raw_name + group[3].rm_so, group[3].rm_eo - group[3].rm_so);
+	if (!tmp) {
+		perror("Error: strndup");
+
+		regfree(&compile);
+
+		free(raw_name);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->vendor);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+	long minor = strtol(tmp, NULL, 16);
+	free(tmp);
+
+	regfree(&compile);
+
+	free(raw_name);
+
+	const size_t UUID = 32;
+
+	if (!(resource->version = (char *) calloc((UUID + 1), sizeof(char)))) {
+		perror("Error: calloc");
+
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->vendor);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	glob_t dev;
+	if (glob("/sys/bus/pci/devices/*/fpga/intel-fpga-dev.*/intel-fpga-port.*/dev", GLOB_NOSORT, NULL, &dev)) {
+		if (glob("/sys/bus/pci/devices/*/fpga_region/region*/dfl-port.*/dev", GLOB_NOSORT, NULL, &dev)) {
+			perror("Error: glob");
+
+			inclReleaseContext(resource->context);
+
+			free(resource->name);
+			free(resource->vendor);
+			free(resource->version);
+			free(resource);
+
+			return INACCEL_FAILED;
+		}
+	}
+
+	size_t i;
+	for (i = 0; i < dev.gl_pathc; i++) {
+		long dev_major;
+		long dev_minor;
+
+		FILE *dev_stream = fopen(dev.gl_pathv[i], "r");
+		if (!dev_stream) {
+			perror("Error: fopen");
+
+			inclReleaseContext(resource->context);
+
+			free(resource->name);
+			free(resource->vendor);
+			free(resource->version);
+			free(resource);
+
+			return INACCEL_FAILED;
+		}
+
+		if (fscanf(dev_stream, "%ld:%ld", &dev_major, &dev_minor) == EOF) {
+			perror("Error: fscanf");
+
+			fclose(dev_stream);
+
+			inclReleaseContext(resource->context);
+
+			free(resource->name);
+			free(resource->vendor);
+			free(resource->version);
+			free(resource);
+
+			return INACCEL_FAILED;
+		}
+
+		fclose(dev_stream);
+
+		if ((major == dev_major) && (minor == dev_minor)) {
+			char *path = dirname(dirname(dev.gl_pathv[i]));
+
+			char compat_id_pattern[PATH_MAX];
+			if (sprintf(compat_id_pattern, "%s/dfl-fme.*/dfl-fme-region.*/fpga_region/region*/compat_id", path) < 0) {
+				perror("Error: sprintf");
+
+				globfree(&dev);
+
+				inclReleaseContext(resource->context);
+
+				free(resource->name);
+				free(resource->vendor);
+				free(resource->version);
+				free(resource);
+
+				return INACCEL_FAILED;
+			}
+
+			char pr_interface_id_pattern[PATH_MAX];
+			if (sprintf(pr_interface_id_pattern, "%s/intel-fpga-fme.*/pr/interface_id", path) < 0) {
+				perror("Error: sprintf");
+
+				globfree(&dev);
+
+				inclReleaseContext(resource->context);
+
+				free(resource->name);
+				free(resource->vendor);
+				free(resource->version);
+				free(resource);
+
+				return INACCEL_FAILED;
+			}
+
+			globfree(&dev);
+
+			glob_t id;
+			if (glob(compat_id_pattern, GLOB_NOSORT, NULL, &id)) {
+				if (glob(pr_interface_id_pattern, GLOB_NOSORT, NULL, &id)) {
+					perror("Error: glob");
+
+					inclReleaseContext(resource->context);
+
+					free(resource->name);
+					free(resource->vendor);
+					free(resource->version);
+					free(resource);
+
+					return INACCEL_FAILED;
+				}
+			}
+
+			FILE *id_stream = fopen(id.gl_pathv[0], "r");
+			if (!id_stream) {
+				perror("Error: fopen");
+
+				globfree(&id);
+
+				inclReleaseContext(resource->context);
+
+				free(resource->name);
+				free(resource->vendor);
+				free(resource->version);
+				free(resource);
+
+				return INACCEL_FAILED;
+			}
+
+			if (!fgets(resource->version, UUID + 1, id_stream)) {
+				perror("Error: fgets");
+
+				globfree(&id);
+
+				fclose(id_stream);
+
+				inclReleaseContext(resource->context);
+
+				free(resource->name);
+				free(resource->vendor);
+				free(resource->version);
+				free(resource);
+
+				return INACCEL_FAILED;
+			}
+
+			fclose(id_stream);
+
+			if (!strncmp(id.gl_pathv[0] + strlen(id.gl_pathv[0]) - strlen("compat_id"), "compat_id", strlen("compat_id"))) {
+				resource->root_path = strdup(dirname(id.gl_pathv[0]));
+			} else if (!strncmp(id.gl_pathv[0] + strlen(id.gl_pathv[0]) - strlen("pr/interface_id"), "pr/interface_id", strlen("pr/interface_id"))) {
+				resource->root_path = strdup(dirname(dirname(id.gl_pathv[0])));
+			}
+
+			globfree(&id);
+
+			break;
+		}
+	}
+
+	if (!strlen(resource->version)) {
+		globfree(&dev);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->vendor);
+		free(resource->version);
+		free(resource);
+
+		return NULL;
+	}
+
+	char *root_path;
+	if ((root_path = strdup(resource->root_path))) {
+		resource->pci_id = strdup(strtok(root_path, "/sys/bus/pci/devices"));
+
+		free(root_path);
+	}
+
+	if (!(resource->command_queue_pool = inclCreateCommandQueuePool(resource->context, resource->device_id))) {
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->root_path);
+		free(resource->vendor);
+		free(resource->version);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	if (!(resource->completion_queue = inclCreateCompletionQueue())) {
+		inclReleaseCommandQueuePool(resource->command_queue_pool);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->root_path);
+		free(resource->vendor);
+		free(resource->version);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	const char *wait_policy = getenv("INACCEL_WAIT_POLICY");
+	if (wait_policy) {
+		if (!strcmp(wait_policy, "spin")) {
+			set_resource_wait_policy(resource, INACCEL_WAIT_SPIN, 0);
+		} else if (!strcmp(wait_policy, "hybrid")) {
+			const char *wait_spin_usec = getenv("INACCEL_WAIT_SPIN_USEC");
+
+			set_resource_wait_policy(resource, INACCEL_WAIT_HYBRID, wait_spin_usec ? strtoul(wait_spin_usec, NULL, 10) : 50);
+		}
+	}
+
+	const char *copy_chunk_size = getenv("INACCEL_COPY_CHUNK_SIZE");
+	if (copy_chunk_size) {
+		/* Chunks are kept page aligned. */
+		resource->copy_chunk_size = (strtoul(copy_chunk_size, NULL, 10) + 4095) & ~((size_t) 4095);
+	}
+
+	const char *submission_policy = getenv("INACCEL_SUBMISSION_POLICY");
+	if (submission_policy && !strcmp(submission_policy, "async")) {
+		if (!(resource->submission_queue = inclCreateSubmissionQueue(&flush_routine, resource))) {
+			inclReleaseCompletionQueue(resource->completion_queue);
+
+			inclReleaseCommandQueuePool(resource->command_queue_pool);
+
+			inclReleaseContext(resource->context);
+
+			free(resource->name);
+			free(resource->root_path);
+			free(resource->vendor);
+			free(resource->version);
+			free(resource);
+
+			return INACCEL_FAILED;
+		}
+	}
+
+	if (pthread_create(&resource->thread, NULL, &sensor_routine, resource)) {
+		perror("Error: pthread_create");
+
+		if (resource->submission_queue) {
+			inclReleaseSubmissionQueue(resource->submission_queue);
+		}
+		inclReleaseCompletionQueue(resource->completion_queue);
+
+		inclReleaseCommandQueuePool(resource->command_queue_pool);
+
+		inclReleaseContext(resource->context);
+
+		free(resource->name);
+		free(resource->root_path);
+		free(resource->vendor);
+		free(resource->version);
+		free(resource);
+
+		return INACCEL_FAILED;
+	}
+
+	return resource;
+}
+
+int fill_buffer(cl_buffer buffer, const void *pattern, size_t pattern_size, size_t offset, size_t size) {
+	if (!pattern_size || pattern_size > MAX_FILL_PATTERN_SIZE || (pattern_size & (pattern_size - 1))) {
+		return EXIT_FAILURE;
+	}
+
+	if (offset > buffer->size || size > buffer->size - offset || offset % pattern_size || size % pattern_size) {
+		return EXIT_FAILURE;
+	}
+
+	if (buffer->memory->resource->submission_queue) {
+		struct buffer_fill *arg = (struct buffer_fill *) inclCreateSubmission(&submit_fill_buffer_routine, sizeof(struct buffer_fill));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
+
+		arg->buffer = buffer;
+		arg->offset = offset;
+		arg->size = size;
+		arg->pattern_size = pattern_size;
+		memcpy(arg->pattern, pattern, pattern_size);
+
+		buffer->submission = inclSubmit(buffer->memory->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (submit_fill_buffer(buffer, pattern, pattern_size, offset, size)) {
+		return EXIT_FAILURE;
+	}
+
+	return inclFlush(buffer->command_queue);
+}
+
+int get_buffer_eventfd(cl_buffer buffer) {
+	wait_for_submission(buffer->memory->resource, buffer->submission);
 
-		return INACCEL_FAILED;
+	if (!buffer->eventfd) {
+		if (!(buffer->eventfd = inclCreateEventfd())) {
+			return -1;
+		}
+
+		if (buffer->event) {
+			inclSignalEventfd(buffer->eventfd, buffer->event);
+		}
 	}
 
-	char *raw_name = (char *) calloc(raw_name_size, sizeof(char));
-	if (!raw_name) {
-		perror("Error: calloc");
+	return inclGetEventfdDescriptor(buffer->eventfd);
+}
 
-		inclReleaseContext(resource->context);
+int get_compute_unit_eventfd(cl_compute_unit compute_unit) {
+	wait_for_submission(compute_unit->resource, compute_unit->submission);
 
-		free(resource->vendor);
-		free(resource);
+	if (!compute_unit->eventfd) {
+		if (!(compute_unit->eventfd = inclCreateEventfd())) {
+			return -1;
+		}
+
+		if (compute_unit->event) {
+			inclSignalEventfd(compute_unit->eventfd, compute_unit->event);
+		}
+	}
+
+	return inclGetEventfdDescriptor(compute_unit->eventfd);
+}
+
+size_t get_memory_size(cl_memory memory) {
+	return memory->size;
+}
+
+const char *get_memory_type(cl_memory memory) {
+	return memory->type;
+}
+
+const char *get_resource_name(cl_resource resource) {
+	return resource->name;
+}
+
+const char *get_resource_pci_id(cl_resource resource) {
+	return resource->pci_id;
+}
+
+float get_resource_power(cl_resource resource) {
+	return resource->power;
+}
+
+const char *get_resource_serial_no(cl_resource resource) {
+	return resource->serial_no;
+}
+
+float get_resource_temperature(cl_resource resource) {
+	return resource->temperature;
+}
+
+const char *get_resource_vendor(cl_resource resource) {
+	return resource->vendor;
+}
+
+const char *get_resource_version(cl_resource resource) {
+	return resource->version;
+}
 
+void *map_buffer(cl_buffer buffer, int flags, size_t offset, size_t size) {
+	if (offset > buffer->size || size > buffer->size - offset) {
 		return INACCEL_FAILED;
 	}
 
-	if (inclGetDeviceInfo(resource->device_id, CL_DEVICE_NAME, raw_name_size, raw_name, NULL)) {
-		free(raw_name);
+	wait_for_submissions(buffer->memory->resource);
 
-		inclReleaseContext(resource->context);
+	cl_map_flags map_flags = 0;
+	if (flags & INACCEL_MAP_READ) {
+		map_flags |= CL_MAP_READ;
+	}
+	if (flags & INACCEL_MAP_WRITE) {
+		map_flags |= CL_MAP_WRITE;
+	}
 
-		free(resource->vendor);
-		free(resource);
+	cl_event event_wait_list[2];
+	cl_uint num_events_in_wait_list = get_buffer_wait_list(buffer, event_wait_list);
 
+	/* Only the mapped range is made visible to the host, once the pending copies and runs of the buffer are done. */
+	void *ptr = inclEnqueueMapBuffer(buffer->command_queue, buffer->mem, CL_TRUE, map_flags, offset, size, num_events_in_wait_list, event_wait_list, NULL);
+	if (!ptr) {
 		return INACCEL_FAILED;
 	}
 
-	if (!(resource->name = (char *) calloc(raw_name_size, sizeof(char)))) {
-		perror("Error: calloc");
+	return ptr;
+}
 
-		free(raw_name);
+int program_resource_with_binary(cl_resource resource, size_t size, const void *binary) {
+	wait_for_submissions(resource);
+
+	if (resource->program) {
+		inclReleaseProgram(resource->program);
+		resource->program = NULL;
+	}
+	if (resource->context) {
+		cl_program program = inclCreateProgramWithBinary(resource->context, resource->device_id, size, binary);
+		if (!program) {
+			return EXIT_FAILURE;
+		}
+
+		inclReleaseProgram(program);
+
+		inclReleaseCommandQueuePool(resource->command_queue_pool);
+		resource->command_queue_pool = NULL;
 
 		inclReleaseContext(resource->context);
+		resource->context = NULL;
+	}
 
-		free(resource->vendor);
-		free(resource);
+	if (!(resource->context = inclCreateContext(resource->device_id))) {
+		return EXIT_FAILURE;
+	}
+	resource->generation++;
 
-		return INACCEL_FAILED;
+	if (!(resource->command_queue_pool = inclCreateCommandQueuePool(resource->context, resource->device_id))) {
+		inclReleaseContext(resource->context);
+		resource->context = NULL;
+
+		return EXIT_FAILURE;
 	}
 
-	const char *regex = "^([^ : ]+) : .*_(.+)0000(.).$";
+	if (!(resource->program = inclCreateProgramWithBinary(resource->context, resource->device_id, size, binary))) {
+		return EXIT_FAILURE;
+	}
 
-	regex_t compile;
-	regmatch_t group[4];
+	if (inclBuildProgram(resource->program)) {
+		inclReleaseProgram(resource->program);
+		resource->program = NULL;
 
-	if (regcomp(&compile, regex, REG_EXTENDED)) {
-		perror("Error: regcomp");
+		return EXIT_FAILURE;
+	}
 
-		free(raw_name);
+	return EXIT_SUCCESS;
+}
 
-		inclReleaseContext(resource->context);
+int push_pipeline_chunk(cl_pipeline pipeline, const void *input, void *output, size_t size) {
+	if (size > pipeline->chunk_size) {
+		return EXIT_FAILURE;
+	}
 
-		free(resource->name);
-		free(resource->vendor);
-		free(resource);
+	unsigned int slot = pipeline->next;
 
-		return INACCEL_FAILED;
+	/* The chunk that last used the same buffers has to complete first, which also frees up its host memory. */
+	if (pipeline->num_pending == pipeline->depth) {
+		if (await_buffer_copy(pipeline->input[slot])) {
+			pipeline->error = 1;
+		}
+		if (await_buffer_copy(pipeline->output[slot])) {
+			pipeline->error = 1;
+		}
+
+		pipeline->num_pending--;
 	}
 
-	if (regexec(&compile, raw_name, 4, group, 0)) {
-		perror("Error: regexec");
+	if (pipeline->compute_unit->resource->submission_queue) {
+		struct pipeline_chunk *pipeline_chunk = (struct pipeline_chunk *) inclCreateSubmission(&submit_pipeline_chunk_routine, sizeof(struct pipeline_chunk));
+		if (!pipeline_chunk) {
+			return EXIT_FAILURE;
+		}
 
-		regfree(&compile);
+		pipeline_chunk->pipeline = pipeline;
+		pipeline_chunk->slot = slot;
+		pipeline_chunk->input = input;
+		pipeline_chunk->output = output;
+		pipeline_chunk->size = size;
 
-		free(raw_name);
+		pipeline->next = (slot + 1) % pipeline->depth;
+		pipeline->num_pending++;
 
-		inclReleaseContext(resource->context);
+		pipeline->compute_unit->submission = inclSubmit(pipeline->compute_unit->resource->submission_queue, pipeline_chunk);
 
-		free(resource->name);
-		free(resource->vendor);
-		free(resource);
+		return EXIT_SUCCESS;
+	}
 
-		return INACCEL_FAILED;
+	pipeline->next = (slot + 1) % pipeline->depth;
+	pipeline->num_pending++;
+
+	if (submit_pipeline_chunk(pipeline, slot, input, output, size)) {
+		return EXIT_FAILURE;
 	}
 
-	strncpy(resource->name, raw_name + group[1].rm_so, group[1].rm_eo - group[1].rm_so);
+	return inclFlushCommandQueuePool(pipeline->compute_unit->resource->command_queue_pool);
+}
 
-	char *tmp;
+void release_buffer(cl_buffer buffer) {
+	wait_for_submissions(buffer->memory->resource);
+
+	if (buffer->sub_buffer || buffer->memory->mem_cache) {
+		/* Neither a region nor a cached buffer can be handed out again before the device is done with it. */
+		cl_event event_wait_list[2];
+		cl_uint num_events_in_wait_list = get_buffer_wait_list(buffer, event_wait_list);
+		if (num_events_in_wait_list) {
+			inclWaitForEvents(num_events_in_wait_list, event_wait_list);
+		}
+	}
 
-	tmp = strndup(raw_name + group[2].rm_so, group[2].rm_eo - group[2].rm_so);
-	if (!tmp) {
-		perror("Error: strndup");
+	if (buffer->event) {
+		inclReleaseEvent(buffer->event);
+	}
+	if (buffer->eventfd) {
+		inclReleaseEventfd(buffer->eventfd);
+	}
+	if (buffer->run_event) {
+		inclReleaseEvent(buffer->run_event);
+	}
+	if (buffer->sub_buffer) {
+		inclReleaseMemObject(buffer->mem);
 
-		regfree(&compile);
+		inclFreeBuddyBlock(buffer->memory->buddy_allocator, buffer->offset);
 
-		free(raw_name);
+		buffer->memory->num_regions--;
+	} else if (!buffer->memory->mem_cache || buffer->zero_copy || buffer->generation != buffer->memory->generation || inclCacheMemObject(buffer->memory->mem_cache, buffer->mem, buffer->mem_size, NULL)) {
+		inclReleaseMemObject(buffer->mem);
+	}
 
-		inclReleaseContext(resource->context);
+	inclReleaseCommandQueue(buffer->command_queue);
 
-		free(resource->name);
-		free(resource->vendor);
-		free(resource);
+	free(buffer);
+}
 
-		return INACCEL_FAILED;
+void release_compute_unit(cl_compute_unit compute_unit) {
+	wait_for_submissions(compute_unit->resource);
+
+	if (compute_unit->event) {
+		inclReleaseEvent(compute_unit->event);
 	}
-	long major = strtol(tmp, NULL, 16);
-	free(tmp);
+	if (compute_unit->eventfd) {
+		inclReleaseEventfd(compute_unit->eventfd);
+	}
+	if (compute_unit->depth > 1) {
+		unsigned int i;
+		for (i = 0; i < compute_unit->depth; i++) {
+			if (compute_unit->run_event[i]) {
+				inclReleaseEvent(compute_unit->run_event[i]);
+			}
+			inclReleaseKernel(compute_unit->kernel_ring[i]);
+		}
 
-	tmp = strndup(raw_name + group[3].rm_so, group[3].rm_eo - group[3].rm_so);
-	if (!tmp) {
-		perror("Error: strndup");
+		free(compute_unit->kernel_arg_version);
+		free(compute_unit->kernel_ring);
+		free(compute_unit->run_event);
+	} else {
+		inclReleaseKernel(compute_unit->kernel);
+	}
+	inclReleaseCommandQueue(compute_unit->command_queue);
 
-		regfree(&compile);
+	unsigned int index;
+	for (index = 0; index < compute_unit->num_args; index++) {
+		free(compute_unit->kernel_arg[index].value);
+	}
 
-		free(raw_name);
+	free(compute_unit->arg_node);
+	free(compute_unit->buffer);
+	free(compute_unit->event_wait_list);
+	free(compute_unit->kernel_arg);
+	free(compute_unit->name);
+	free(compute_unit);
+}
 
-		inclReleaseContext(resource->context);
+void release_graph(cl_graph graph) {
+	wait_for_submissions(graph->resource);
 
-		free(resource->name);
-		free(resource->vendor);
-		free(resource);
+	unsigned int i;
+	for (i = 0; i < graph->num_nodes; i++) {
+		struct graph_node *node = graph->node[i];
 
-		return INACCEL_FAILED;
+		if (node->type == GRAPH_NODE_COMPUTE_UNIT_ARG && node->compute_unit->arg_node[node->index] == node) {
+			node->compute_unit->arg_node[node->index] = NULL;
+		}
+
+		free(node->last);
+		free(node);
 	}
-	long minor = strtol(tmp, NULL, 16);
-	free(tmp);
 
-	regfree(&compile);
+	free(graph->node);
+	free(graph);
+}
 
-	free(raw_name);
+void release_memory(cl_memory memory) {
+	wait_for_submissions(memory->resource);
 
-	const size_t UUID = 32;
+	if (memory->buddy_allocator) {
+		inclReleaseBuddyAllocator(memory->buddy_allocator);
 
-	if (!(resource->version = (char *) calloc((UUID + 1), sizeof(char)))) {
-		perror("Error: calloc");
+		release_buffer(memory->arena);
+	}
+	if (memory->mem_cache) {
+		inclReleaseMemCache(memory->mem_cache);
+	}
 
-		inclReleaseContext(resource->context);
+	free(memory->type);
+	free(memory);
+}
 
-		free(resource->name);
-		free(resource->vendor);
-		free(resource);
+void release_pipeline(cl_pipeline pipeline) {
+	wait_for_submissions(pipeline->compute_unit->resource);
 
-		return INACCEL_FAILED;
+	unsigned int slot;
+	for (slot = 0; slot < pipeline->depth; slot++) {
+		release_buffer(pipeline->input[slot]);
+		release_buffer(pipeline->output[slot]);
 	}
 
-	glob_t dev;
-	if (glob("/sys/bus/pci/devices/*/fpga/intel-fpga-dev.*/intel-fpga-port.*/dev", GLOB_NOSORT, NULL, &dev)) {
-		if (glob("/sys/bus/pci/devices/*/fpga_region/region*/dfl-port.*/dev", GLOB_NOSORT, NULL, &dev)) {
-			perror("Error: glob");
+	free(pipeline->input);
+	free(pipeline->output);
+	free(pipeline);
+}
 
-			inclReleaseContext(resource->context);
+void release_resource(cl_resource resource) {
+	resource->release = 1;
+	pthread_join(resource->thread, NULL);
 
-			free(resource->name);
-			free(resource->vendor);
-			free(resource->version);
-			free(resource);
+	if (resource->submission_queue) {
+		inclReleaseSubmissionQueue(resource->submission_queue);
+	}
+	inclReleaseCompletionQueue(resource->completion_queue);
 
-			return INACCEL_FAILED;
+	if (resource->program) {
+		inclReleaseProgram(resource->program);
+	}
+	if (resource->context) {
+		inclReleaseCommandQueuePool(resource->command_queue_pool);
+		inclReleaseContext(resource->context);
+	}
+
+	free(resource->name);
+	free(resource->pci_id);
+	free(resource->root_path);
+	free(resource->serial_no);
+	free(resource->vendor);
+	free(resource->version);
+	free(resource);
+}
+
+int repeat_compute_unit_run(cl_compute_unit compute_unit, unsigned int num_runs, unsigned int index, size_t size, const void *values) {
+	if (!num_runs) {
+		return EXIT_SUCCESS;
+	}
+
+	if (!values) {
+		size = 0;
+	} else if (index >= compute_unit->num_args) {
+		return EXIT_FAILURE;
+	}
+
+	if (compute_unit->resource->submission_queue) {
+		struct compute_unit_runs *arg = (struct compute_unit_runs *) inclCreateSubmission(&submit_repeat_compute_unit_run_routine, sizeof(struct compute_unit_runs) + num_runs * size);
+		if (!arg) {
+			return EXIT_FAILURE;
 		}
+
+		arg->compute_unit = compute_unit;
+		arg->num_runs = num_runs;
+		arg->index = index;
+		arg->size = size;
+		arg->values = memcpy(arg + 1, values, num_runs * size);
+
+		compute_unit->submission = inclSubmit(compute_unit->resource->submission_queue, arg);
+
+		return EXIT_SUCCESS;
 	}
 
-	size_t i;
-	for (i = 0; i < dev.gl_pathc; i++) {
-		long dev_major;
-		long dev_minor;
+	if (submit_repeat_compute_unit_run(compute_unit, num_runs, index, size, values)) {
+		return EXIT_FAILURE;
+	}
 
-		FILE *dev_stream = fopen(dev.gl_pathv[i], "r");
-		if (!dev_stream) {
-			perror("Error: fopen");
+	return inclFlush(compute_unit->command_queue);
+}
+
+int replay_graph(cl_graph graph) {
+	if (graph->resource->submission_queue) {
+		cl_graph *arg = (cl_graph *) inclCreateSubmission(&submit_graph_routine, sizeof(cl_graph));
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
 
-			inclReleaseContext(resource->context);
+		*arg = graph;
 
-			free(resource->name);
-			free(resource->vendor);
-			free(resource->version);
-			free(resource);
+		unsigned long submission = inclSubmit(graph->resource->submission_queue, arg);
 
-			return INACCEL_FAILED;
+		unsigned int i;
+		for (i = 0; i < graph->num_nodes; i++) {
+			if (graph->node[i]->buffer) {
+				graph->node[i]->buffer->submission = submission;
+			}
+			if (graph->node[i]->compute_unit) {
+				graph->node[i]->compute_unit->submission = submission;
+			}
 		}
 
-		if (fscanf(dev_stream, "%ld:%ld", &dev_major, &dev_minor) == EOF) {
-			perror("Error: fscanf");
-
-			fclose(dev_stream);
+		return EXIT_SUCCESS;
+	}
 
-			inclReleaseContext(resource->context);
+	if (submit_graph(graph)) {
+		return EXIT_FAILURE;
+	}
 
-			free(resource->name);
-			free(resource->vendor);
-			free(resource->version);
-			free(resource);
+	return inclFlushCommandQueuePool(graph->resource->command_queue_pool);
+}
 
-			return INACCEL_FAILED;
+int run_compute_unit(cl_compute_unit compute_unit) {
+	if (compute_unit->resource->submission_queue) {
+		cl_compute_unit *arg = (cl_compute_unit *) inclCreateSubmission(&submit_run_compute_unit_routine, sizeof(cl_compute_unit));
+		if (!arg) {
+			return EXIT_FAILURE;
 		}
 
-		fclose(dev_stream);
-
-		if ((major == dev_major) && (minor == dev_minor)) {
-			char *path = dirname(dirname(dev.gl_pathv[i]));
+		*arg = compute_unit;
 
-			char compat_id_pattern[PATH_MAX];
-			if (sprintf(compat_id_pattern, "%s/dfl-fme.*/dfl-fme-region.*/fpga_region/region*/compat_id", path) < 0) {
-				perror("Error: sprintf");
+		compute_unit->submission = inclSubmit(compute_unit->resource->submission_queue, arg);
 
-				globfree(&dev);
+		return EXIT_SUCCESS;
+	}
 
-				inclReleaseContext(resource->context);
+	if (submit_run_compute_unit(compute_unit)) {
+		return EXIT_FAILURE;
+	}
 
-				free(resource->name);
-				free(resource->vendor);
-				free(resource->version);
-				free(resource);
+	return inclFlush(compute_unit->command_queue);
+}
 
-				return INACCEL_FAILED;
-			}
+int set_buffer_copy_callback(cl_buffer buffer, void (*callback)(int error, void *user_data), void *user_data) {
+	wait_for_submission(buffer->memory->resource, buffer->submission);
 
-			char pr_interface_id_pattern[PATH_MAX];
-			if (sprintf(pr_interface_id_pattern, "%s/intel-fpga-fme.*/pr/interface_id", path) < 0) {
-				perror("Error: sprintf");
+	return inclEnqueueCompletion(buffer->memory->resource->completion_queue, buffer->event, callback, user_data);
+}
 
-				globfree(&dev);
+int set_compute_unit_arg(cl_compute_unit compute_unit, unsigned int index, size_t size, const void *value) {
+	if (index >= compute_unit->num_args) {
+		return EXIT_FAILURE;
+	}
 
-				inclReleaseContext(resource->context);
+	if (compute_unit->resource->submission_queue) {
+		struct compute_unit_arg *arg = (struct compute_unit_arg *) inclCreateSubmission(&submit_compute_unit_arg_routine, sizeof(struct compute_unit_arg) + size);
+		if (!arg) {
+			return EXIT_FAILURE;
+		}
 
-				free(resource->name);
-				free(resource->vendor);
-				free(resource->version);
-				free(resource);
+		arg->compute_unit = compute_unit;
+		arg->index = index;
+		arg->size = size;
+		/* Scalars are copied along, since the caller may reuse their storage as soon as the call returns. */
+		arg->value = size ? memcpy(arg + 1, value, size) : value;
 
-				return INACCEL_FAILED;
-			}
+		compute_unit->submission = inclSubmit(compute_unit->resource->submission_queue, arg);
 
-			globfree(&dev);
+		return EXIT_SUCCESS;
+	}
 
-			glob_t id;
-			if (glob(compat_id_pattern, GLOB_NOSORT, NULL, &id)) {
-				if (glob(pr_interface_id_pattern, GLOB_NOSORT, NULL, &id)) {
-					perror("Error: glob");
+	return submit_compute_unit_arg(compute_unit, index, size, value);
+}
 
-					inclReleaseContext(resource->context);
+int set_compute_unit_depth(cl_compute_unit compute_unit, unsigned int depth) {
+	if (!depth || depth > MAX_COMPUTE_UNIT_DEPTH) {
+		return EXIT_FAILURE;
+	}
 
-					free(resource->name);
-					free(resource->vendor);
-					free(resource->version);
-					free(resource);
+	/* Kernel instances are only swapped once no run is in flight. */
+	int error = await_compute_unit_run(compute_unit);
 
-					return INACCEL_FAILED;
-				}
-			}
+	cl_kernel *kernel_ring = NULL;
+	cl_event *run_event = NULL;
+	unsigned long *kernel_arg_version = NULL;
 
-			FILE *id_stream = fopen(id.gl_pathv[0], "r");
-			if (!id_stream) {
-				perror("Error: fopen");
+	if (depth > 1) {
+		if (!(kernel_ring = (cl_kernel *) calloc(depth, sizeof(cl_kernel)))) {
+			perror("Error: calloc");
 
-				globfree(&id);
+			return EXIT_FAILURE;
+		}
 
-				inclReleaseContext(resource->context);
+		if (!(run_event = (cl_event *) calloc(depth, sizeof(cl_event)))) {
+			perror("Error: calloc");
 
-				free(resource->name);
-				free(resource->vendor);
-				free(resource->version);
-				free(resource);
+			free(kernel_ring);
 
-				return INACCEL_FAILED;
-			}
+			return EXIT_FAILURE;
+		}
 
-			if (!fgets(resource->version, UUID + 1, id_stream)) {
-				perror("Error: fgets");
+		if (!(kernel_arg_version = (unsigned long *) calloc(depth * compute_unit->num_args, sizeof(unsigned long)))) {
+			perror("Error: calloc");
 
-				globfree(&id);
+			free(kernel_ring);
+			free(run_event);
 
-				fclose(id_stream);
+			return EXIT_FAILURE;
+		}
 
-				inclReleaseContext(resource->context);
+		/* The current instance is kept, and is up to date with every argument. */
+		kernel_ring[0] = compute_unit->kernel;
 
-				free(resource->name);
-				free(resource->vendor);
-				free(resource->version);
-				free(resource);
+		unsigned int index;
+		for (index = 0; index < compute_unit->num_args; index++) {
+			kernel_arg_version[index] = compute_unit->kernel_arg[index].version;
+		}
 
-				return INACCEL_FAILED;
-			}
+		unsigned int i;
+		for (i = 1; i < depth; i++) {
+			if (!(kernel_ring[i] = inclCreateKernel(compute_unit->resource->program, compute_unit->name))) {
+				while (--i) {
+					inclReleaseKernel(kernel_ring[i]);
+				}
 
-			fclose(id_stream);
+				free(kernel_arg_version);
+				free(kernel_ring);
+				free(run_event);
 
-			if (!strncmp(id.gl_pathv[0] + strlen(id.gl_pathv[0]) - strlen("compat_id"), "compat_id", strlen("compat_id"))) {
-				resource->root_path = strdup(dirname(id.gl_pathv[0]));
-			} else if (!strncmp(id.gl_pathv[0] + strlen(id.gl_pathv[0]) - strlen("pr/interface_id"), "pr/interface_id", strlen("pr/interface_id"))) {
-				resource->root_path = strdup(dirname(dirname(id.gl_pathv[0])));
+				return EXIT_FAILURE;
 			}
-
-			globfree(&id);
-
-			break;
 		}
 	}
 
-	if (!strlen(resource->version)) {
-		globfree(&dev);
+	cl_event *event_wait_list = (cl_event *) realloc(compute_unit->event_wait_list, (depth + 2 * compute_unit->num_args) * sizeof(cl_event));
+	if (!event_wait_list) {
+		perror("Error: realloc");
 
-		inclReleaseContext(resource->context);
+		if (depth > 1) {
+			unsigned int i;
+			for (i = 1; i < depth; i++) {
+				inclReleaseKernel(kernel_ring[i]);
+			}
+		}
 
-		free(resource->name);
-		free(resource->vendor);
-		free(resource->version);
-		free(resource);
+		free(kernel_arg_version);
+		free(kernel_ring);
+		free(run_event);
 
-		return NULL;
+		return EXIT_FAILURE;
 	}
+	compute_unit->event_wait_list = event_wait_list;
 
-	char *root_path;
-	if ((root_path = strdup(resource->root_path))) {
-		resource->pci_id = strdup(strtok(root_path, "/sys/bus/pci/devices"));
+	if (compute_unit->depth > 1) {
+		unsigned int i;
+		for (i = 0; i < compute_unit->depth; i++) {
+			if (compute_unit->run_event[i]) {
+				inclReleaseEvent(compute_unit->run_event[i]);
+			}
+			if (i != compute_unit->next) {
+				inclReleaseKernel(compute_unit->kernel_ring[i]);
+			}
+		}
 
-		free(root_path);
+		free(compute_unit->kernel_arg_version);
+		free(compute_unit->kernel_ring);
+		free(compute_unit->run_event);
 	}
 
-	if (pthread_create(&resource->thread, NULL, &sensor_routine, resource)) {
-		perror("Error: pthread_create");
-
-		inclReleaseContext(resource->context);
+	compute_unit->depth = depth;
+	compute_unit->next = 0;
+	compute_unit->kernel_ring = kernel_ring;
+	compute_unit->run_event = run_event;
+	compute_unit->kernel_arg_version = kernel_arg_version;
 
-		free(resource->name);
-		free(resource->root_path);
-		free(resource->vendor);
-		free(resource->version);
-		free(resource);
+	return error;
+}
 
-		return INACCEL_FAILED;
-	}
+int set_compute_unit_run_callback(cl_compute_unit compute_unit, void (*callback)(int error, void *user_data), void *user_data) {
+	wait_for_submission(compute_unit->resource, compute_unit->submission);
 
-	return resource;
+	return inclEnqueueCompletion(compute_unit->resource->completion_queue, compute_unit->event, callback, user_data);
 }
 
-size_t get_memory_size(cl_memory memory) {
-	return memory->size;
+int set_resource_wait_policy(cl_resource resource, int policy, unsigned int spin_usec) {
+	switch (policy) {
+		case INACCEL_WAIT_BLOCK:
+			resource->wait_spin_usec = 0;
+			return EXIT_SUCCESS;
+		case INACCEL_WAIT_SPIN:
+			resource->wait_spin_usec = ULONG_MAX;
+			return EXIT_SUCCESS;
+		case INACCEL_WAIT_HYBRID:
+			resource->wait_spin_usec = spin_usec;
+			return EXIT_SUCCESS;
+		default:
+			return EXIT_FAILURE;
+	}
 }
 
-const char *get_memory_type(cl_memory memory) {
-	return memory->type;
-}
+int test_buffer_copy(cl_buffer buffer) {
+	unsigned long timeout_usec = 0;
+	if (timed_wait_for_submission(buffer->memory->resource, buffer->submission, &timeout_usec)) {
+		return INACCEL_PENDING;
+	}
 
-const char *get_resource_name(cl_resource resource) {
-	return resource->name;
-}
+	if (buffer->error) {
+		buffer->error = 0;
 
-const char *get_resource_pci_id(cl_resource resource) {
-	return resource->pci_id;
-}
+		return EXIT_FAILURE;
+	}
 
-float get_resource_power(cl_resource resource) {
-	return resource->power;
-}
+	if (!buffer->event) {
+		return EXIT_SUCCESS;
+	}
 
-const char *get_resource_serial_no(cl_resource resource) {
-	return resource->serial_no;
-}
+	cl_int status;
+	if (inclGetEventInfo(buffer->event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(cl_int), &status, NULL)) {
+		return EXIT_FAILURE;
+	}
 
-float get_resource_temperature(cl_resource resource) {
-	return resource->temperature;
-}
+	if (status > CL_COMPLETE) {
+		return INACCEL_PENDING;
+	}
 
-const char *get_resource_vendor(cl_resource resource) {
-	return resource->vendor;
-}
+	inclReleaseEvent(buffer->event);
+	buffer->event = NULL;
 
-const char *get_resource_version(cl_resource resource) {
-	return resource->version;
+	return status < CL_COMPLETE ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
-int program_resource_with_binary(cl_resource resource, size_t size, const void *binary) {
-	if (resource->program) {
-		inclReleaseProgram(resource->program);
-		resource->program = NULL;
+int test_compute_unit_run(cl_compute_unit compute_unit) {
+	unsigned long timeout_usec = 0;
+	if (timed_wait_for_submission(compute_unit->resource, compute_unit->submission, &timeout_usec)) {
+		return INACCEL_PENDING;
 	}
-	if (resource->context) {
-		cl_program program = inclCreateProgramWithBinary(resource->context, resource->device_id, size, binary);
-		if (!program) {
-			return EXIT_FAILURE;
-		}
 
-		inclReleaseProgram(program);
+	if (compute_unit->error) {
+		compute_unit->error = 0;
 
-		inclReleaseContext(resource->context);
-		resource->context = NULL;
+		return EXIT_FAILURE;
 	}
 
-	if (!(resource->context = inclCreateContext(resource->device_id))) {
-		return EXIT_FAILURE;
+	if (!compute_unit->event) {
+		return EXIT_SUCCESS;
 	}
 
-	if (!(resource->program = inclCreateProgramWithBinary(resource->context, resource->device_id, size, binary))) {
+	cl_int status;
+	if (inclGetEventInfo(compute_unit->event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(cl_int), &status, NULL)) {
 		return EXIT_FAILURE;
 	}
 
-	if (inclBuildProgram(resource->program)) {
-		inclReleaseProgram(resource->program);
-		resource->program = NULL;
-
-		return EXIT_FAILURE;
+	if (status > CL_COMPLETE) {
+		return INACCEL_PENDING;
 	}
 
-	return EXIT_SUCCESS;
+	inclReleaseEvent(compute_unit->event);
+	compute_unit->event = NULL;
+
+	return status < CL_COMPLETE ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
-void release_buffer(cl_buffer buffer) {
-	inclReleaseCommandQueue(buffer->command_queue);
-	inclReleaseMemObject(buffer->mem);
+int timed_await_buffer_copy(cl_buffer buffer, unsigned long timeout_usec) {
+	if (timed_wait_for_submission(buffer->memory->resource, buffer->submission, &timeout_usec)) {
+		return INACCEL_TIMEDOUT;
+	}
 
-	free(buffer);
-}
+	if (buffer->error) {
+		buffer->error = 0;
 
-void release_compute_unit(cl_compute_unit compute_unit) {
-	inclReleaseCommandQueue(compute_unit->command_queue);
-	inclReleaseKernel(compute_unit->kernel);
+		return EXIT_FAILURE;
+	}
 
-	free(compute_unit->name);
-	free(compute_unit);
-}
+	if (!buffer->event) {
+		return EXIT_SUCCESS;
+	}
 
-void release_memory(cl_memory memory) {
-	free(memory->type);
-	free(memory);
+	int error = inclTimedWaitForEvent(buffer->event, buffer->memory->resource->wait_spin_usec, timeout_usec);
+	if (error == ETIMEDOUT) {
+		return INACCEL_TIMEDOUT;
+	}
+
+	inclReleaseEvent(buffer->event);
+	buffer->event = NULL;
+
+	return error;
 }
 
-void release_resource(cl_resource resource) {
-	resource->release = 1;
-	pthread_join(resource->thread, NULL);
+int timed_await_compute_unit_run(cl_compute_unit compute_unit, unsigned long timeout_usec) {
+	if (timed_wait_for_submission(compute_unit->resource, compute_unit->submission, &timeout_usec)) {
+		return INACCEL_TIMEDOUT;
+	}
 
-	if (resource->program) {
-		inclReleaseProgram(resource->program);
+	if (compute_unit->error) {
+		compute_unit->error = 0;
+
+		return EXIT_FAILURE;
 	}
-	if (resource->context) {
-		inclReleaseContext(resource->context);
+
+	if (!compute_unit->event) {
+		return EXIT_SUCCESS;
 	}
 
-	free(resource->name);
-	free(resource->pci_id);
-	free(resource->root_path);
-	free(resource->serial_no);
-	free(resource->vendor);
-	free(resource->version);
-	free(resource);
-}
+	int error = inclTimedWaitForEvent(compute_unit->event, compute_unit->resource->wait_spin_usec, timeout_usec);
+	if (error == ETIMEDOUT) {
+		return INACCEL_TIMEDOUT;
+	}
 
-int run_compute_unit(cl_compute_unit compute_unit) {
-	return inclEnqueueTask(compute_unit->command_queue, compute_unit->kernel);
+	inclReleaseEvent(compute_unit->event);
+	compute_unit->event = NULL;
+
+	return error;
 }
 
-int set_compute_unit_arg(cl_compute_unit compute_unit, unsigned int index, size_t size, const void *value) {
-	if (size) {
-		return inclSetKernelArg(compute_unit->kernel, index, size, value);
-	} else {
-		cl_buffer buffer = (cl_buffer) value;
+int unmap_buffer(cl_buffer buffer, void *ptr) {
+	wait_for_submissions(buffer->memory->resource);
 
-		return inclSetKernelArg(compute_unit->kernel, index, sizeof(cl_mem), &buffer->mem);
+	cl_event event_wait_list[2];
+	cl_uint num_events_in_wait_list = get_buffer_wait_list(buffer, event_wait_list);
+
+	cl_event event;
+	if (inclEnqueueUnmapMemObject(buffer->command_queue, buffer->mem, ptr, num_events_in_wait_list, event_wait_list, &event)) {
+		return EXIT_FAILURE;
 	}
+
+	set_buffer_event(buffer, event);
+
+	return inclFlush(buffer->command_queue);
 }
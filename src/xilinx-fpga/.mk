@@ -1,3 +1,3 @@
-xilinx-fpga = inaccel/runtime/intercept INCL/opencl runtime
+xilinx-fpga = inaccel/runtime/intercept INCL/buddy INCL/cache INCL/event INCL/opencl INCL/pool INCL/submit runtime
 xilinx-fpga_CFLAGS = -O3 -Wall -DNDEBUG -fPIC
 xilinx-fpga_LDFLAGS = -shared -Wl,--allow-multiple-definition